@@ -0,0 +1,116 @@
+<?php
+
+/**
+ * Offline benchmarks of the value codecs, no cluster required.
+ *
+ * Usage: php benchmarks/codecs.php [--iterations=N] [--filter=name]
+ */
+
+require_once __DIR__ . '/runner.php';
+
+use Cassandra\Bigint;
+use Cassandra\Blob;
+use Cassandra\Decimal;
+use Cassandra\Inet;
+use Cassandra\Map;
+use Cassandra\Set;
+use Cassandra\Varint;
+
+if (!extension_loaded('cassandra')) {
+    fwrite(STDERR, "The cassandra extension must be loaded to run benchmarks" . PHP_EOL);
+    exit(1);
+}
+
+$runner = new BenchmarkRunner('codecs');
+
+$decimal = new Decimal('-12345678901234567890.0123456789');
+$varint  = new Varint('123456789012345678901234567890');
+$bytes   = str_repeat("\x00\x01\x02\x03\xfd\xfe\xff", 64);
+$blob    = new Blob($bytes);
+$inet    = new Inet('2001:db8:85a3::8a2e:370:7334');
+
+$runner->add('decimal.parse', function ($i) {
+    return new Decimal('-12345678901234567890.0123456789');
+});
+
+$runner->add('decimal.parse_exponent', function ($i) {
+    return new Decimal('1.2345678901234567890e-20');
+});
+
+$runner->add('decimal.format', function ($i) use ($decimal) {
+    return (string) $decimal;
+});
+
+$runner->add('varint.parse', function ($i) {
+    return new Varint('123456789012345678901234567890');
+});
+
+$runner->add('varint.parse_hex', function ($i) {
+    return new Varint('0x18ee90ff6c373e0ee4e3f0ad2');
+});
+
+$runner->add('varint.format', function ($i) use ($varint) {
+    return (string) $varint;
+});
+
+$runner->add('bigint.parse', function ($i) {
+    return new Bigint('-9223372036854775807');
+});
+
+$runner->add('inet.parse_ipv4', function ($i) {
+    return new Inet('192.168.100.200');
+});
+
+$runner->add('inet.parse_ipv6', function ($i) {
+    return new Inet('2001:db8:85a3::8a2e:370:7334');
+});
+
+$runner->add('inet.format', function ($i) use ($inet) {
+    return (string) $inet;
+});
+
+$runner->add('blob.to_hex', function ($i) use ($blob) {
+    return $blob->bytes();
+});
+
+$runner->add('set.add_varchar', function ($i) {
+    $set = new Set(\Cassandra::TYPE_VARCHAR);
+    for ($j = 0; $j < 16; $j++) {
+        $set->add("value{$j}");
+    }
+    return $set;
+});
+
+$runner->add('set.add_varint', function ($i) {
+    $set = new Set(\Cassandra::TYPE_VARINT);
+    for ($j = 0; $j < 16; $j++) {
+        $set->add(new Varint($j));
+    }
+    return $set;
+});
+
+$runner->add('set.add_blob', function ($i) use ($blob) {
+    $set = new Set(\Cassandra::TYPE_BLOB);
+    for ($j = 0; $j < 16; $j++) {
+        $set->add($blob);
+    }
+    return $set;
+});
+
+$runner->add('map.set_varchar_bigint', function ($i) {
+    $map = new Map(\Cassandra::TYPE_VARCHAR, \Cassandra::TYPE_BIGINT);
+    for ($j = 0; $j < 16; $j++) {
+        $map->set("key{$j}", new Bigint($j));
+    }
+    return $map;
+});
+
+$runner->add('map.set_inet_decimal', function ($i) use ($decimal) {
+    $map = new Map(\Cassandra::TYPE_INET, \Cassandra::TYPE_DECIMAL);
+    for ($j = 0; $j < 16; $j++) {
+        $map->set(new Inet("10.0.0.{$j}"), $decimal);
+    }
+    return $map;
+});
+
+$runner->run();
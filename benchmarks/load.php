@@ -0,0 +1,193 @@
+<?php
+
+/**
+ * End-to-end load generator for the PHP -> driver -> socket path.
+ *
+ * Unless --host is given, a local stand-in server (support/native_server.php)
+ * is started for the duration of the run, so no cluster is needed.
+ *
+ * Usage: php benchmarks/load.php [--mode=execute|async|prepared|paging|batch]
+ *                                [--requests=10000] [--concurrency=32]
+ *                                [--host=127.0.0.1] [--port=9142]
+ *                                [--protocol=3] [--rows=10] [--page-size=100]
+ *                                [--batch-size=10] [--latency-ms=0]
+ *                                [--server-config=rules.json]
+ */
+
+require_once __DIR__ . '/runner.php';
+
+use Cassandra\BatchStatement;
+use Cassandra\ExecutionOptions;
+use Cassandra\SimpleStatement;
+
+if (!extension_loaded('cassandra')) {
+    fwrite(STDERR, "The cassandra extension must be loaded to run benchmarks" . PHP_EOL);
+    exit(1);
+}
+
+$options = getopt('', array(
+    'mode:', 'requests:', 'concurrency:', 'host:', 'port:', 'protocol:',
+    'rows:', 'page-size:', 'batch-size:', 'latency-ms:', 'server-config:',
+));
+
+$option = function ($name, $default) use ($options) {
+    return isset($options[$name]) ? $options[$name] : $default;
+};
+
+$mode        = $option('mode', 'execute');
+$requests    = max(1, (int) $option('requests', 10000));
+$concurrency = max(1, (int) $option('concurrency', 32));
+$port        = (int) $option('port', 9142);
+$rows        = (int) $option('rows', 10);
+$pageSize    = (int) $option('page-size', 100);
+$batchSize   = (int) $option('batch-size', 10);
+$server      = null;
+
+if (isset($options['host'])) {
+    $host = $options['host'];
+} else {
+    $host    = '127.0.0.1';
+    $command = escapeshellarg(PHP_BINARY) . ' ' .
+               escapeshellarg(__DIR__ . '/../support/native_server.php') .
+               ' --host=' . $host .
+               ' --port=' . $port .
+               ' --rows=' . ($mode == 'paging' ? $rows * $pageSize : $rows) .
+               ' --latency-ms=' . (float) $option('latency-ms', 0);
+
+    if (isset($options['server-config'])) {
+        $command .= ' --config=' . escapeshellarg($options['server-config']);
+    }
+
+    $server = proc_open($command, array(2 => array('pipe', 'w')), $pipes);
+
+    if (!is_resource($server) || strpos(fgets($pipes[2]), 'Listening') !== 0) {
+        fwrite(STDERR, "Unable to start the stand-in server" . PHP_EOL);
+        exit(1);
+    }
+}
+
+$cluster = Cassandra::cluster()
+               ->withContactPoints($host)
+               ->withPort($port)
+               ->withProtocolVersion((int) $option('protocol', 3))
+               ->withTokenAwareRouting(false)
+               ->build();
+$session = $cluster->connect();
+
+$select    = new SimpleStatement('SELECT key, value FROM stub.values');
+$latencies = array();
+$errors    = 0;
+
+$timed = function ($operation) use (&$latencies, &$errors) {
+    $start = microtime(true);
+    try {
+        $operation();
+    } catch (Cassandra\Exception $e) {
+        $errors++;
+    }
+    $latencies[] = microtime(true) - $start;
+};
+
+$start = microtime(true);
+
+switch ($mode) {
+case 'execute':
+    for ($i = 0; $i < $requests; $i++) {
+        $timed(function () use ($session, $select) {
+            $session->execute($select);
+        });
+    }
+    break;
+
+case 'prepared':
+    $prepared  = $session->prepare('SELECT key, value FROM stub.values WHERE key = ?');
+    for ($i = 0; $i < $requests; $i++) {
+        $timed(function () use ($session, $prepared, $i) {
+            $session->execute($prepared, new ExecutionOptions(array('arguments' => array("key{$i}"))));
+        });
+    }
+    break;
+
+case 'async':
+    $inflight = array();
+    for ($i = 0; $i < $requests || $inflight; $i++) {
+        if ($i < $requests) {
+            $inflight[] = array($session->executeAsync($select), microtime(true));
+        }
+
+        if (count($inflight) >= $concurrency || $i >= $requests) {
+            list($future, $submitted) = array_shift($inflight);
+            try {
+                $future->get();
+            } catch (Cassandra\Exception $e) {
+                $errors++;
+            }
+            $latencies[] = microtime(true) - $submitted;
+        }
+    }
+    break;
+
+case 'paging':
+    $paging = new ExecutionOptions(array('page_size' => $pageSize));
+    for ($i = 0; $i < $requests;) {
+        $result = null;
+        $timed(function () use ($session, $select, $paging, &$result) {
+            $result = $session->execute($select, $paging);
+        });
+        $i++;
+        while ($result && !$result->isLastPage() && $i < $requests) {
+            $timed(function () use (&$result) {
+                $result = $result->nextPage();
+            });
+            $i++;
+        }
+    }
+    break;
+
+case 'batch':
+    $insert = new SimpleStatement('INSERT INTO stub.values (key, value) VALUES (?, ?)');
+    for ($i = 0; $i < $requests; $i++) {
+        $batch = new BatchStatement(Cassandra::BATCH_UNLOGGED);
+        for ($j = 0; $j < $batchSize; $j++) {
+            $batch->add($insert, array("key{$j}", new Cassandra\Bigint($j)));
+        }
+        $timed(function () use ($session, $batch) {
+            $session->execute($batch);
+        });
+    }
+    break;
+
+default:
+    fwrite(STDERR, "Unknown mode {$mode}" . PHP_EOL);
+    exit(1);
+}
+
+$elapsed = microtime(true) - $start;
+
+$session->close();
+
+if ($server) {
+    proc_terminate($server);
+    proc_close($server);
+}
+
+sort($latencies);
+
+$percentile = function ($p) use ($latencies) {
+    $index = (int) ceil($p * count($latencies)) - 1;
+    return round($latencies[max(0, $index)] * 1000, 3);
+};
+
+$runner = new BenchmarkRunner('load');
+$runner->report($mode, array(
+    'requests'    => count($latencies),
+    'errors'      => $errors,
+    'concurrency' => $mode == 'async' ? $concurrency : 1,
+    'seconds'     => round($elapsed, 6),
+    'ops_per_sec' => (int) round(count($latencies) / $elapsed),
+    'p50_ms'      => $percentile(0.50),
+    'p90_ms'      => $percentile(0.90),
+    'p99_ms'      => $percentile(0.99),
+    'p999_ms'     => $percentile(0.999),
+    'max_ms'      => $percentile(1.0),
+));
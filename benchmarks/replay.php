@@ -0,0 +1,35 @@
+<?php
+
+/**
+ * Benchmarks decoding of results recorded with `cassandra.record_results`.
+ *
+ * Usage: php benchmarks/replay.php [--iterations=N] recording...
+ */
+
+require_once __DIR__ . '/runner.php';
+
+use Cassandra\Recording;
+
+if (!extension_loaded('cassandra')) {
+    fwrite(STDERR, "The cassandra extension must be loaded to run benchmarks" . PHP_EOL);
+    exit(1);
+}
+
+$recordings = array_filter(array_slice($argv, 1), function ($argument) {
+    return strpos($argument, '--') !== 0;
+});
+
+if (empty($recordings)) {
+    fwrite(STDERR, "Usage: php benchmarks/replay.php [--iterations=N] recording..." . PHP_EOL);
+    exit(1);
+}
+
+$runner = new BenchmarkRunner('replay');
+
+foreach ($recordings as $recording) {
+    $runner->add(basename($recording), function ($i) use ($recording) {
+        return Recording::replay($recording);
+    });
+}
+
+$runner->run();
@@ -0,0 +1,107 @@
+<?php
+
+/**
+ * Minimal benchmark runner shared by the scripts in this directory.
+ *
+ * A benchmark is a closure performing a single operation and returning its
+ * result. The runner reports the time per operation, with the cost of the
+ * closure call itself subtracted, and the memory retained by each result.
+ * Results are written to STDOUT as one JSON object per line so that runs of
+ * different releases can be stored and compared by other tools.
+ */
+class BenchmarkRunner
+{
+    const RETAINED_SAMPLES = 1000;
+
+    private $suite;
+    private $iterations;
+    private $filter;
+    private $benchmarks;
+    private $overhead;
+
+    public function __construct($suite)
+    {
+        $options = getopt('', array('iterations:', 'filter:'));
+
+        $this->suite      = $suite;
+        $this->iterations = isset($options['iterations']) ? max(1, (int) $options['iterations']) : 100000;
+        $this->filter     = isset($options['filter']) ? $options['filter'] : null;
+        $this->benchmarks = array();
+        $this->overhead   = null;
+    }
+
+    public function add($name, $operation)
+    {
+        $this->benchmarks[$name] = $operation;
+    }
+
+    public function run()
+    {
+        $this->overhead = $this->time(function ($i) { return $i; }, $this->iterations);
+
+        foreach ($this->benchmarks as $name => $operation) {
+            if ($this->filter && strpos($name, $this->filter) === false) {
+                continue;
+            }
+
+            $this->report($name, $this->measure($operation));
+        }
+    }
+
+    public function report($name, array $result)
+    {
+        $result = array_merge(array(
+            'suite'     => $this->suite,
+            'benchmark' => $name,
+            'php'       => PHP_VERSION,
+            'driver'    => phpversion('cassandra'),
+        ), $result);
+
+        fwrite(STDOUT, json_encode($result) . PHP_EOL);
+    }
+
+    private function measure($operation)
+    {
+        // warm up the allocator before taking any measurement
+        $this->time($operation, min($this->iterations, 1000));
+
+        $elapsed = max(0.0, $this->time($operation, $this->iterations) - $this->overhead);
+
+        return array(
+            'iterations'   => $this->iterations,
+            'seconds'      => round($elapsed, 6),
+            'ops_per_sec'  => $elapsed > 0 ? (int) round($this->iterations / $elapsed) : null,
+            'ns_per_op'    => round($elapsed * 1000000000 / $this->iterations, 1),
+            'bytes_per_op' => $this->retained($operation),
+        );
+    }
+
+    private function time($operation, $iterations)
+    {
+        $start = microtime(true);
+
+        for ($i = 0; $i < $iterations; $i++) {
+            $operation($i);
+        }
+
+        return microtime(true) - $start;
+    }
+
+    private function retained($operation)
+    {
+        $results = array();
+        $results = array_pad($results, self::RETAINED_SAMPLES, null);
+
+        gc_collect_cycles();
+        $memory = memory_get_usage();
+
+        for ($i = 0; $i < self::RETAINED_SAMPLES; $i++) {
+            $results[$i] = $operation($i);
+        }
+
+        $memory = memory_get_usage() - $memory;
+        unset($results);
+
+        return (int) round($memory / self::RETAINED_SAMPLES);
+    }
+}
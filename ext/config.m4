@@ -56,8 +56,17 @@ if test "$PHP_CASSANDRA" != "no"; then
     src/Cassandra/ExecutionOptions.c \
     src/Cassandra/SimpleStatement.c \
     src/Cassandra/PreparedStatement.c \
+    src/Cassandra/BoundStatement.c \
     src/Cassandra/BatchStatement.c \
     src/Cassandra/Rows.c \
+    src/Cassandra/Stats.c \
+    src/Cassandra/Recording.c \
+    src/Cassandra/Metrics.c \
+    src/Cassandra/RetryPolicy.c \
+    src/Cassandra/RetryPolicy/Default.c \
+    src/Cassandra/RetryPolicy/DowngradingConsistency.c \
+    src/Cassandra/RetryPolicy/Fallthrough.c \
+    src/Cassandra/RetryPolicy/Logging.c \
     src/Cassandra/Column.c \
     src/Cassandra/DefaultColumn.c \
     src/Cassandra/DefaultKeyspace.c \
@@ -92,14 +101,27 @@ if test "$PHP_CASSANDRA" != "no"; then
   ";
 
   CASSANDRA_UTIL="\
+    util/async_log.c \
+    util/bind.c \
     util/bytes.c \
     util/collections.c \
     util/consistency.c \
+    util/execution_info.c \
+    util/fork.c \
     util/future.c \
     util/inet.c \
+    util/iterator.c \
     util/math.c \
+    util/metrics.c \
+    util/prewarm.c \
+    util/psession.c \
+    util/rate_limit.c \
+    util/recording.c \
     util/ref.c \
     util/result.c \
+    util/schema.c \
+    util/slow_query.c \
+    util/stats.c \
     util/types.c \
     util/uuid_gen.c \
   ";
@@ -119,6 +141,7 @@ if test "$PHP_CASSANDRA" != "no"; then
   PHP_ADD_BUILD_DIR($ext_builddir/src/Cassandra)
   PHP_ADD_BUILD_DIR($ext_builddir/src/Cassandra/Cluster)
   PHP_ADD_BUILD_DIR($ext_builddir/src/Cassandra/Exception)
+  PHP_ADD_BUILD_DIR($ext_builddir/src/Cassandra/RetryPolicy)
   PHP_ADD_BUILD_DIR($ext_builddir/src/Cassandra/SSLOptions)
   PHP_ADD_BUILD_DIR($ext_builddir/src/Cassandra/Type)
   PHP_ADD_BUILD_DIR($ext_builddir/util)
@@ -205,6 +228,9 @@ if test "$PHP_CASSANDRA" != "no"; then
   PHP_ADD_LIBRARY(uv,, CASSANDRA_SHARED_LIBADD)
   PHP_ADD_LIBRARY(m,, CASSANDRA_SHARED_LIBADD)
 
+  dnl Lets a worker recover the statistics lock of a worker that died with it
+  PHP_CHECK_FUNC(pthread_mutexattr_setrobust, pthread)
+
   if test "$PHP_CASSANDRA" != "yes"; then
     if test -f $PHP_CASSANDRA/include/cassandra.h; then
       CPP_DRIVER_DIR=$PHP_CASSANDRA
@@ -21,6 +21,7 @@
  *
  * Use Cassandra::cluster() to build a cluster instance.
  * Use Cassandra::ssl() to build SSL options instance.
+ * Use Cassandra::session() to get a session declared in php.ini.
  */
 final class Cassandra
 {
@@ -337,4 +338,27 @@ final class Cassandra
      * @return Cassandra\SSLOptions\Builder an SSLOptions Builder instance
      */
     public static function ssl() {}
+
+    /**
+     * Returns a session declared in the `cassandra.sessions` ini setting.
+     *
+     * Declared sessions start connecting on the first request handled by a
+     * worker and are kept for its lifetime, so later requests don't pay for
+     * connection setup. Each declaration has the form
+     * `name=contact_points[/keyspace][?option=value&...]`, declarations are
+     * separated by semicolons. Supported options are `port`, `username`,
+     * `password`, `local_dc`, `protocol_version`, `io_threads`,
+     * `core_connections`, `max_connections`, `connect_timeout_ms`,
+     * `request_timeout_ms` and `token_aware`.
+     *
+     * @param string     $name    name of the declared session
+     * @param float|null $timeout maximum time in seconds to wait for the
+     *                            session to be connected
+     *
+     * @throws Cassandra\Exception\InvalidArgumentException when the session
+     *                                                       isn't declared
+     *
+     * @return Cassandra\Session a connected session
+     */
+    public static function session($name, $timeout = null) {}
 }
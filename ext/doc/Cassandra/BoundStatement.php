@@ -0,0 +1,54 @@
+<?php
+
+/**
+ * Copyright 2015 DataStax, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+namespace Cassandra;
+
+/**
+ * A prepared statement with its values bound, which can be executed many
+ * times. Values are bound once and stay bound between executions, so only
+ * the ones that change need to be bound again.
+ *
+ * Arguments given via `ExecutionOptions` are bound on top of the values of
+ * the statement for that execution only.
+ *
+ * @see Session::prepare()
+ */
+final class BoundStatement implements Statement
+{
+    /**
+     * Creates a new bound statement.
+     *
+     * @throws Exception\InvalidArgumentException
+     *
+     * @param PreparedStatement $statement the statement to bind values to
+     * @param array|null        $arguments positional or named arguments
+     */
+    public function __construct(PreparedStatement $statement, array $arguments = null) {}
+
+    /**
+     * Binds a value to a parameter, replacing the one bound before.
+     *
+     * @throws Exception\InvalidArgumentException
+     *
+     * @param string|int $name  the name or the position of the parameter
+     * @param mixed      $value the value to bind
+     *
+     * @return BoundStatement self
+     */
+    public function bind($name, $value) {}
+}
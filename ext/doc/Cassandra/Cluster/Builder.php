@@ -146,6 +146,54 @@ final class Builder
      */
     public function withSSL(\Cassandra\SSLOptions $options) {}
 
+    /**
+     * Configures the retry policy used by all requests of the cluster,
+     * unless overridden via `ExecutionOptions`.
+     *
+     * @param \Cassandra\RetryPolicy $policy the retry policy
+     *
+     * @return Builder self
+     */
+    public function withRetryPolicy(\Cassandra\RetryPolicy $policy) {}
+
+    /**
+     * Registers a named execution profile. The name can then be given to
+     * `Session::execute()` and `Session::executeAsync()` in place of an
+     * `ExecutionOptions` instance, or as its `profile` option. Registering
+     * a profile twice replaces it.
+     *
+     * @throws Exception\InvalidArgumentException when the options contain
+     *                                            arguments or a profile
+     *
+     * @param string                       $name    the name of the profile
+     * @param \Cassandra\ExecutionOptions $options the options of the profile
+     *
+     * @return Builder self
+     */
+    public function withExecutionProfile($name, \Cassandra\ExecutionOptions $options) {}
+
+    /**
+     * Limits the rate of requests sent by the sessions of this cluster.
+     * Requests are throttled before being handed to the driver, either by
+     * waiting until the request fits in the limit or, in fail-fast mode, by
+     * throwing a `Cassandra\Exception\RuntimeException`. Short bursts of up
+     * to one second worth of requests are allowed.
+     *
+     * Clusters with the same contact points and limits share their limit
+     * within a process, or across all the workers of a SAPI when the
+     * `cassandra.rate_limit_shared` ini setting is enabled.
+     *
+     * @param int|null $requestsPerSecond the maximum number of requests per
+     *                                    second, `null` for no limit
+     * @param int|null $bytesPerSecond    the maximum number of request bytes
+     *                                    per second, estimated from the query
+     *                                    and its arguments, `null` for no limit
+     * @param bool     $failFast          whether to throw instead of waiting
+     *
+     * @return Builder self
+     */
+    public function withRateLimit($requestsPerSecond, $bytesPerSecond = null, $failFast = false) {}
+
     /**
      * Enable persistent sessions and clusters.
      *
@@ -234,4 +282,38 @@ final class Builder
      * @return Builder self
      */
     public function withTCPKeepalive($delay) {}
+
+    /**
+     * Enables/disables fetching of schema metadata. Disabling it makes
+     * connecting faster, which helps short-lived workers that never call
+     * `Session::schema()`; the schema returned by a session connected without
+     * metadata is empty.
+     *
+     * @param bool $enabled whether to fetch schema metadata on connect.
+     *
+     * @return Builder self
+     */
+    public function withSchemaMetadata($enabled = true) {}
+
+    /**
+     * Enables/disables speculative execution of idempotent statements. Once
+     * the delay has passed without a response, the request is also sent to
+     * the next host of the query plan; the first response wins. Requires
+     * version 2.7.0 or later of the C/C++ driver.
+     *
+     * @param float|null $delay         the delay in seconds before starting
+     *                                  another execution, up to 4294967. If
+     *                                  set to `null`, disables speculative
+     *                                  execution.
+     * @param int        $maxExecutions the maximum number of additional
+     *                                  executions per request.
+     *
+     * @see ExecutionOptions::__construct()
+     *
+     * @throws Exception\InvalidArgumentException
+     * @throws Exception\RuntimeException when the C/C++ driver is older than 2.7.0
+     *
+     * @return Builder self
+     */
+    public function withSpeculativeExecution($delay, $maxExecutions = 1) {}
 }
@@ -32,27 +32,43 @@ final class DefaultSession implements Session
      */
     public function schema() {}
 
+    /**
+     * {@inheritDoc}
+     *
+     * @return int|null schema version
+     */
+    public function schemaVersion() {}
+
+    /**
+     * {@inheritDoc}
+     *
+     * @return array session metrics
+     */
+    public function metrics() {}
+
     /**
      * {@inheritDoc}
      *
      * @throws Exception
      *
-     * @param Statement        $statement statement to be executed
-     * @param ExecutionOptions $options   execution options (optional)
+     * @param Statement               $statement statement to be executed
+     * @param ExecutionOptions|string $options   execution options or the name
+     *                                           of an execution profile (optional)
      *
      * @return Rows execution result
      */
-    public function execute(Statement $statement, ExecutionOptions $options = null) {}
+    public function execute(Statement $statement, $options = null) {}
 
     /**
      * {@inheritDoc}
      *
-     * @param Statement             $statement statement to be executed
-     * @param ExecutionOptions|null $options   execution options (optional)
+     * @param Statement                    $statement statement to be executed
+     * @param ExecutionOptions|string|null $options   execution options or the name
+     *                                                of an execution profile (optional)
      *
      * @return Future future result
      */
-    public function executeAsync(Statement $statement, ExecutionOptions $options = null) {}
+    public function executeAsync(Statement $statement, $options = null) {}
 
     /**
      * {@inheritDoc}
@@ -36,6 +36,23 @@ final class ExecutionOptions
      * * array['timeout']            int|null A number of seconds or null
      * * array['page_size']          int      A number of rows to include in result for paging
      * * array['serial_consistency'] int      Either Cassandra::CONSISTENCY_SERIAL or Cassandra::CONSISTENCY_LOCAL_SERIAL
+     * * array['idempotent']         bool     Whether the statement can be safely executed more than once
+     * * array['retry_policy']       RetryPolicy A retry policy that overrides the cluster's one
+     * * array['profile']            string   The name of an execution profile to start from
+     *
+     * With version 2.5.0 or later of the C/C++ driver, the timeout is also
+     * sent to the driver as the request timeout of the statement, so a
+     * request that times out is cancelled instead of being left running. It
+     * then applies to asynchronous executions as well. Older versions only
+     * stop waiting for the result.
+     *
+     * Only idempotent statements are executed speculatively when the cluster
+     * has a speculative execution policy.
+     *
+     * Options given explicitly override the ones of the execution profile.
+     *
+     * @see Cluster\Builder::withSpeculativeExecution()
+     * @see Cluster\Builder::withExecutionProfile()
      *
      * @throws Exception\InvalidArgumentException
      *
@@ -36,4 +36,13 @@ final class FutureRows implements Future
      * @return mixed a value that the future has been resolved with
      */
     public function get($timeout = null) {}
+
+    /**
+     * Get the timing breakdown of the request collected so far.
+     *
+     * @see Rows::executionInfo()
+     *
+     * @return array|null execution info or null when collection is disabled
+     */
+    public function executionInfo() {}
 }
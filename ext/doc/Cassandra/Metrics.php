@@ -0,0 +1,42 @@
+<?php
+
+/**
+ * Copyright 2015 DataStax, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+namespace Cassandra;
+
+/**
+ * Renders driver and extension metrics for scraping by Prometheus.
+ */
+final class Metrics
+{
+    /**
+     * Returns the current metrics in the OpenMetrics text format.
+     *
+     * Extension counters (requests, errors, binding errors, prepared
+     * statements, decoded rows, bytes and time) are aggregated across
+     * processes when `cassandra.stats_size` is set and per process
+     * otherwise. Driver metrics are reported for up to 16 persistent sessions
+     * of the calling process, labelled by index and keyspace. Nothing is sent
+     * to the cluster.
+     *
+     * Decoded rows, bytes and time are only counted when `cassandra.metrics`
+     * is enabled, because measuring them adds work to every result.
+     *
+     * @return string OpenMetrics exposition, terminated by `# EOF`
+     */
+    public static function export() {}
+}
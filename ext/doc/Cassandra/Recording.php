@@ -0,0 +1,45 @@
+<?php
+
+/**
+ * Copyright 2015 DataStax, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+namespace Cassandra;
+
+/**
+ * Replays results recorded with the `cassandra.record_results` setting.
+ *
+ * When `cassandra.record_results` is set to a file name in php.ini, the
+ * column metadata and raw row data of every result decoded by the extension
+ * is appended to that file. Replaying a recording runs it through the same
+ * value decoding as live results without any cluster, which makes it
+ * possible to profile and benchmark decoding against real data shapes.
+ *
+ * Recordings contain the data returned by the queries, keep them safe.
+ */
+final class Recording
+{
+    /**
+     * Decodes every result stored in a recording.
+     *
+     * @param string $filename path to a recording
+     *
+     * @throws Exception\RuntimeException when the file can't be read or is corrupted
+     *
+     * @return array a list of results, each one a list of rows as returned by
+     *               iterating over `Cassandra\Rows`
+     */
+    public static function replay($filename) {}
+}
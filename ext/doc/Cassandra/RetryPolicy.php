@@ -0,0 +1,36 @@
+<?php
+
+/**
+ * Copyright 2015 DataStax, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+namespace Cassandra;
+
+/**
+ * All retry policies implement this common interface. A retry policy
+ * decides, inside the driver, whether a request that failed with a read
+ * timeout, a write timeout or an unavailable error is retried, retried at a
+ * lower consistency, or returned as an error.
+ *
+ * @see RetryPolicy\DefaultPolicy
+ * @see RetryPolicy\DowngradingConsistency
+ * @see RetryPolicy\Fallthrough
+ * @see RetryPolicy\Logging
+ * @see Cluster\Builder::withRetryPolicy()
+ * @see ExecutionOptions::__construct()
+ */
+interface RetryPolicy
+{
+}
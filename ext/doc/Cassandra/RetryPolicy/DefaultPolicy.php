@@ -0,0 +1,29 @@
+<?php
+
+/**
+ * Copyright 2015 DataStax, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+namespace Cassandra\RetryPolicy;
+
+/**
+ * The default retry policy. It retries a read timeout once when enough
+ * replicas answered but no data was returned, a write timeout once when it
+ * happened while writing a batch log, and an unavailable error once on the
+ * next host.
+ */
+final class DefaultPolicy implements \Cassandra\RetryPolicy
+{
+}
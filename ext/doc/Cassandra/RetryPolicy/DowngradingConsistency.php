@@ -0,0 +1,30 @@
+<?php
+
+/**
+ * Copyright 2015 DataStax, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+namespace Cassandra\RetryPolicy;
+
+/**
+ * A retry policy that retries requests at a lower consistency level when
+ * not enough replicas are available or answered in time.
+ *
+ * This policy can break the consistency guarantees expected from the
+ * original consistency level, use it with care.
+ */
+final class DowngradingConsistency implements \Cassandra\RetryPolicy
+{
+}
@@ -0,0 +1,33 @@
+<?php
+
+/**
+ * Copyright 2015 DataStax, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+namespace Cassandra\RetryPolicy;
+
+/**
+ * A retry policy that logs the decisions of another retry policy.
+ */
+final class Logging implements \Cassandra\RetryPolicy
+{
+    /**
+     * Creates a new logging retry policy.
+     *
+     * @param \Cassandra\RetryPolicy $childPolicy the policy whose decisions
+     *                                            are logged
+     */
+    public function __construct(\Cassandra\RetryPolicy $childPolicy) {}
+}
@@ -145,4 +145,21 @@ final class Rows implements \Iterator, \Countable, \ArrayAccess
      * @return array|null returns first row if any
      */
     public function first() {}
+
+    /**
+     * Get the timing breakdown of the request that produced these rows.
+     *
+     * Collection is only enabled when the `cassandra.execution_info` ini
+     * setting is on, or when the slow query log is enabled through
+     * `cassandra.slow_query_threshold_ms`. Timestamps are monotonic nanoseconds; `bind_time`,
+     * `wait_time` and `decode_time` are in seconds. When a request fails
+     * the same array is set as the `executionInfo` property of the thrown
+     * exception.
+     *
+     * @return array|null timestamps (`bind_start`, `bind_end`, `submit`,
+     *                    `response`, `decode_end`), `result_size` in bytes,
+     *                    `row_count` and derived durations, or null when
+     *                    collection is disabled
+     */
+    public function executionInfo() {}
 }
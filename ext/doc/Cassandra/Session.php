@@ -30,23 +30,62 @@ interface Session
      *
      * NOTE: the returned Schema instance will not be updated as the actual
      *       schema changes, instead an updated instance should be requested by
-     *       calling Session::schema() again.
+     *       calling Session::schema() again. Instances returned while the
+     *       schema is unchanged share the same underlying snapshot.
      *
      * @return Schema current schema.
      */
     public function schema();
 
+    /**
+     * Returns the version of the current schema snapshot.
+     *
+     * The version changes whenever the driver receives schema updates, which
+     * makes it a cheap way to invalidate caches built from `schema()`.
+     *
+     * @return int|null schema version, `null` when not supported by the
+     *                  underlying C/C++ driver
+     */
+    public function schemaVersion();
+
+    /**
+     * Returns performance metrics collected by the underlying C/C++ driver
+     * for this session.
+     *
+     * The result is an array with the following keys:
+     *
+     * * `requests` - request latency histogram in microseconds (`min`, `max`,
+     *   `mean`, `stddev`, `median`, `percentile_75th`, `percentile_95th`,
+     *   `percentile_98th`, `percentile_99th`, `percentile_999th`) and request
+     *   rates in requests per second (`mean_rate`, `one_minute_rate`,
+     *   `five_minute_rate`, `fifteen_minute_rate`).
+     * * `stats` - connection counters (`total_connections`,
+     *   `available_connections`, `exceeded_pending_requests_water_mark`,
+     *   `exceeded_write_bytes_water_mark`).
+     * * `errors` - timeout counters (`connection_timeouts`,
+     *   `pending_request_timeouts`, `request_timeouts`).
+     * * `speculative_executions` - speculative executions aborted because
+     *   another execution answered first (`aborted`, `aborted_rate` as a
+     *   percentage of requests) and their latency in microseconds (`min`,
+     *   `max`, `mean`, `median`, `percentile_99th`). Only present when the
+     *   underlying C/C++ driver supports it.
+     *
+     * @return array session metrics
+     */
+    public function metrics();
+
     /**
      * Executes a given statement and returns a result.
      *
      * @throws Exception
      *
-     * @param Statement        $statement statement to be executed
-     * @param ExecutionOptions $options   execution options (optional)
+     * @param Statement               $statement statement to be executed
+     * @param ExecutionOptions|string $options   execution options or the name
+     *                                           of an execution profile (optional)
      *
      * @return Rows execution result
      */
-    public function execute(Statement $statement, ExecutionOptions $options = null);
+    public function execute(Statement $statement, $options = null);
 
     /**
      * Executes a given statement and returns a future result.
@@ -54,12 +93,13 @@ interface Session
      * Note that this method ignores timeout specified in the ExecutionOptions,
      * you can provide one to Future::get() instead.
      *
-     * @param Statement             $statement statement to be executed
-     * @param ExecutionOptions|null $options   execution options (optional)
+     * @param Statement                    $statement statement to be executed
+     * @param ExecutionOptions|string|null $options   execution options or the name
+     *                                                of an execution profile (optional)
      *
      * @return Future future result
      */
-    public function executeAsync(Statement $statement, ExecutionOptions $options = null);
+    public function executeAsync(Statement $statement, $options = null);
 
     /**
      * Creates a prepared statement from a given CQL string.
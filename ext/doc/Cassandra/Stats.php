@@ -0,0 +1,45 @@
+<?php
+
+/**
+ * Copyright 2015 DataStax, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+namespace Cassandra;
+
+/**
+ * Per-statement execution statistics aggregated across all processes that
+ * share the extension, similar to `pg_stat_statements`.
+ *
+ * Collection is enabled by setting `cassandra.stats_size` (the maximum
+ * number of distinct statements tracked) in php.ini. Statements are keyed
+ * by their CQL text, truncated to 255 bytes; all batches are tracked under
+ * a single `<batch>` entry. When `cassandra.stats_dump_interval` is set,
+ * the `cassandra.stats_dump_top` statements with the highest total time
+ * are written to `cassandra.log` at most once per interval.
+ */
+final class Stats
+{
+    /**
+     * Returns the statistics of every tracked statement, ordered by total
+     * time spent, highest first.
+     *
+     * Each entry contains `cql`, `calls`, `errors`, `rows`, and
+     * `total_time`, `min_time`, `max_time`, `mean_time` and `p99_time` in
+     * seconds. `p99_time` is approximated from a power-of-two histogram.
+     *
+     * @return array statement statistics, empty when collection is disabled
+     */
+    public static function statements() {}
+}
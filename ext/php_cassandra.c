@@ -9,6 +9,15 @@
 #include <fcntl.h>
 #include <uv.h>
 
+#include "util/async_log.h"
+#include "util/fork.h"
+#include "util/metrics.h"
+#include "util/prewarm.h"
+#include "util/psession.h"
+#include "util/rate_limit.h"
+#include "util/stats.h"
+#include "util/types.h"
+
 #define PHP_CASSANDRA_DEFAULT_LOG       "cassandra.log"
 #define PHP_CASSANDRA_DEFAULT_LOG_LEVEL "ERROR"
 
@@ -80,8 +89,8 @@ php_cassandra_log_initialize()
   cass_log_set_callback(php_cassandra_log, NULL);
 }
 
-static void
-php_cassandra_log(const CassLogMessage* message, void* data)
+void
+php_cassandra_log_line(const char* severity, const char* message)
 {
   char log[MAXPATHLEN + 1];
   uint log_length = 0;
@@ -100,16 +109,14 @@ php_cassandra_log(const CassLogMessage* message, void* data)
     int fd = -1;
 #ifndef _WIN32
     if (!strcmp(log, "syslog")) {
-      php_syslog(LOG_NOTICE, "cassandra | [%s] %s (%s:%d)",
-                 cass_log_level_string(message->severity), message->message,
-                 message->file, message->line);
+      php_syslog(LOG_NOTICE, "cassandra | [%s] %s", severity, message);
       return;
     }
 #endif
 
     fd = open(log, O_CREAT | O_APPEND | O_WRONLY, 0644);
 
-    if (fd != 1) {
+    if (fd != -1) {
       time_t log_time;
       struct tm log_tm;
       char log_time_str[32];
@@ -120,18 +127,12 @@ php_cassandra_log(const CassLogMessage* message, void* data)
       php_localtime_r(&log_time, &log_tm);
       strftime(log_time_str, sizeof(log_time_str), "%d-%m-%Y %H:%M:%S %Z", &log_tm);
 
-      needed = snprintf(NULL, 0, "%s [%s] %s (%s:%d)%s",
-                        log_time_str,
-                        cass_log_level_string(message->severity), message->message,
-                        message->file, message->line,
-                        PHP_EOL);
+      needed = snprintf(NULL, 0, "%s [%s] %s%s",
+                        log_time_str, severity, message, PHP_EOL);
 
       tmp = malloc(needed + 1);
-      sprintf(tmp, "%s [%s] %s (%s:%d)%s",
-              log_time_str,
-              cass_log_level_string(message->severity), message->message,
-              message->file, message->line,
-              PHP_EOL);
+      sprintf(tmp, "%s [%s] %s%s",
+              log_time_str, severity, message, PHP_EOL);
 
       write(fd, tmp, needed);
       free(tmp);
@@ -145,10 +146,18 @@ php_cassandra_log(const CassLogMessage* message, void* data)
    * logging function are thread-safe.
    */
 
-  fprintf(stderr, "cassandra | [%s] %s (%s:%d)%s",
-          cass_log_level_string(message->severity), message->message,
-          message->file, message->line,
-          PHP_EOL);
+  fprintf(stderr, "cassandra | [%s] %s%s", severity, message, PHP_EOL);
+}
+
+static void
+php_cassandra_log(const CassLogMessage* message, void* data)
+{
+  char line[CASS_LOG_MAX_MESSAGE_SIZE + MAXPATHLEN + 32];
+
+  snprintf(line, sizeof(line), "%s (%s:%d)",
+           message->message, message->file, message->line);
+
+  php_cassandra_log_line(cass_log_level_string(message->severity), line);
 }
 
 static int le_cassandra_cluster_res;
@@ -181,9 +190,7 @@ php_cassandra_session_dtor(zend_rsrc_list_entry* rsrc TSRMLS_DC)
   cassandra_psession* psession = (cassandra_psession*) rsrc->ptr;
 
   if (psession) {
-    cass_future_free(psession->future);
-    cass_session_free(psession->session);
-    pefree(psession, 1);
+    php_cassandra_psession_free(psession);
     CASSANDRA_G(persistent_sessions)--;
     rsrc->ptr = NULL;
   }
@@ -246,6 +253,28 @@ static PHP_INI_MH(OnUpdateLog)
 PHP_INI_BEGIN()
 PHP_INI_ENTRY("cassandra.log",       PHP_CASSANDRA_DEFAULT_LOG,       PHP_INI_ALL, OnUpdateLog)
 PHP_INI_ENTRY("cassandra.log_level", PHP_CASSANDRA_DEFAULT_LOG_LEVEL, PHP_INI_ALL, OnUpdateLogLevel)
+STD_PHP_INI_BOOLEAN("cassandra.execution_info", "0", PHP_INI_ALL, OnUpdateBool,
+                    execution_info, zend_cassandra_globals, cassandra_globals)
+STD_PHP_INI_BOOLEAN("cassandra.metrics", "0", PHP_INI_ALL, OnUpdateBool,
+                    metrics, zend_cassandra_globals, cassandra_globals)
+STD_PHP_INI_ENTRY("cassandra.slow_query_threshold_ms", "0", PHP_INI_ALL, OnUpdateLong,
+                  slow_query_threshold_ms, zend_cassandra_globals, cassandra_globals)
+STD_PHP_INI_BOOLEAN("cassandra.slow_query_log_arguments", "0", PHP_INI_ALL, OnUpdateBool,
+                    slow_query_log_arguments, zend_cassandra_globals, cassandra_globals)
+STD_PHP_INI_ENTRY("cassandra.stats_size", "0", PHP_INI_SYSTEM, OnUpdateLong,
+                  stats_size, zend_cassandra_globals, cassandra_globals)
+STD_PHP_INI_ENTRY("cassandra.stats_dump_interval", "0", PHP_INI_ALL, OnUpdateLong,
+                  stats_dump_interval, zend_cassandra_globals, cassandra_globals)
+STD_PHP_INI_ENTRY("cassandra.stats_dump_top", "10", PHP_INI_ALL, OnUpdateLong,
+                  stats_dump_top, zend_cassandra_globals, cassandra_globals)
+STD_PHP_INI_ENTRY("cassandra.record_results", "", PHP_INI_SYSTEM|PHP_INI_PERDIR, OnUpdateString,
+                  record_results, zend_cassandra_globals, cassandra_globals)
+STD_PHP_INI_ENTRY("cassandra.max_persistent_sessions", "0", PHP_INI_SYSTEM, OnUpdateLong,
+                  max_persistent_sessions, zend_cassandra_globals, cassandra_globals)
+STD_PHP_INI_ENTRY("cassandra.sessions", "", PHP_INI_SYSTEM, OnUpdateString,
+                  sessions, zend_cassandra_globals, cassandra_globals)
+STD_PHP_INI_BOOLEAN("cassandra.rate_limit_shared", "0", PHP_INI_SYSTEM, OnUpdateBool,
+                    rate_limit_shared, zend_cassandra_globals, cassandra_globals)
 PHP_INI_END()
 
 static PHP_GINIT_FUNCTION(cassandra)
@@ -255,6 +284,18 @@ static PHP_GINIT_FUNCTION(cassandra)
   cassandra_globals->uuid_gen            = cass_uuid_gen_new();
   cassandra_globals->persistent_clusters = 0;
   cassandra_globals->persistent_sessions = 0;
+  cassandra_globals->execution_info      = 0;
+  cassandra_globals->metrics             = 0;
+  cassandra_globals->slow_query_threshold_ms = 0;
+  cassandra_globals->slow_query_log_arguments = 0;
+  cassandra_globals->stats_size          = 0;
+  cassandra_globals->stats_dump_interval = 0;
+  cassandra_globals->stats_dump_top      = 10;
+  cassandra_globals->record_results      = NULL;
+  cassandra_globals->sessions            = NULL;
+  cassandra_globals->sessions_prewarmed  = 0;
+  cassandra_globals->max_persistent_sessions = 0;
+  cassandra_globals->rate_limit_shared   = 0;
   cassandra_globals->type_varchar        = NULL;
   cassandra_globals->type_text           = NULL;
   cassandra_globals->type_blob           = NULL;
@@ -271,6 +312,7 @@ static PHP_GINIT_FUNCTION(cassandra)
   cassandra_globals->type_timestamp      = NULL;
   cassandra_globals->type_uuid           = NULL;
   cassandra_globals->type_timeuuid       = NULL;
+  cassandra_globals->type_registry       = NULL;
 }
 
 static PHP_GSHUTDOWN_FUNCTION(cassandra)
@@ -283,6 +325,19 @@ PHP_MINIT_FUNCTION(cassandra)
 {
   REGISTER_INI_ENTRIES();
 
+  if (php_cassandra_stats_startup(CASSANDRA_G(stats_size)) == FAILURE) {
+    php_error_docref(NULL TSRMLS_CC, E_WARNING,
+                     "cassandra | Unable to allocate %ld statement statistics entries",
+                     CASSANDRA_G(stats_size));
+  }
+
+  if (php_cassandra_rate_limit_startup(CASSANDRA_G(rate_limit_shared)) == FAILURE) {
+    php_error_docref(NULL TSRMLS_CC, E_WARNING,
+                     "cassandra | Unable to share rate limits between processes");
+  }
+
+  php_cassandra_fork_startup();
+
   le_cassandra_cluster_res =
   zend_register_list_destructors_ex(NULL, php_cassandra_cluster_dtor,
                                     PHP_CASSANDRA_CLUSTER_RES_NAME,
@@ -351,9 +406,18 @@ PHP_MINIT_FUNCTION(cassandra)
   cassandra_define_Statement(TSRMLS_C);
   cassandra_define_SimpleStatement(TSRMLS_C);
   cassandra_define_PreparedStatement(TSRMLS_C);
+  cassandra_define_BoundStatement(TSRMLS_C);
   cassandra_define_BatchStatement(TSRMLS_C);
   cassandra_define_ExecutionOptions(TSRMLS_C);
   cassandra_define_Rows(TSRMLS_C);
+  cassandra_define_Stats(TSRMLS_C);
+  cassandra_define_Recording(TSRMLS_C);
+  cassandra_define_Metrics(TSRMLS_C);
+  cassandra_define_RetryPolicy(TSRMLS_C);
+  cassandra_define_RetryPolicyDefault(TSRMLS_C);
+  cassandra_define_RetryPolicyDowngradingConsistency(TSRMLS_C);
+  cassandra_define_RetryPolicyFallthrough(TSRMLS_C);
+  cassandra_define_RetryPolicyLogging(TSRMLS_C);
 
   cassandra_define_Schema(TSRMLS_C);
   cassandra_define_DefaultSchema(TSRMLS_C);
@@ -378,16 +442,34 @@ PHP_MSHUTDOWN_FUNCTION(cassandra)
 {
   /* UNREGISTER_INI_ENTRIES(); */
 
+  php_cassandra_stats_shutdown();
+  php_cassandra_rate_limit_shutdown();
+  php_cassandra_async_log_shutdown();
+
   return SUCCESS;
 }
 
 PHP_RINIT_FUNCTION(cassandra)
 {
+  php_cassandra_fork_check(TSRMLS_C);
+
+  /* Declared sessions start connecting on the first request of a worker */
+  if (!CASSANDRA_G(sessions_prewarmed)) {
+    CASSANDRA_G(sessions_prewarmed) = 1;
+    php_cassandra_prewarm_startup(TSRMLS_C);
+  }
+
   return SUCCESS;
 }
 
 PHP_RSHUTDOWN_FUNCTION(cassandra)
 {
+  php_cassandra_stats_dump(CASSANDRA_G(stats_dump_interval),
+                           CASSANDRA_G(stats_dump_top));
+
+  php_cassandra_psession_rebuild(TSRMLS_C);
+  php_cassandra_psession_evict(CASSANDRA_G(max_persistent_sessions) TSRMLS_CC);
+
   if (CASSANDRA_G(type_varchar)) {
     zval_ptr_dtor(&CASSANDRA_G(type_varchar));
     CASSANDRA_G(type_varchar) = NULL;
@@ -468,9 +550,39 @@ PHP_RSHUTDOWN_FUNCTION(cassandra)
     CASSANDRA_G(type_timeuuid) = NULL;
   }
 
+  php_cassandra_type_registry_destroy(TSRMLS_C);
+
   return SUCCESS;
 }
 
+static void
+php_cassandra_print_persistent_sessions_metrics(TSRMLS_D)
+{
+  HashPosition pos;
+  zend_rsrc_list_entry* le;
+  char* key;
+  uint key_len;
+  ulong index;
+  char title[256];
+
+  zend_hash_internal_pointer_reset_ex(&EG(persistent_list), &pos);
+  while (zend_hash_get_current_data_ex(&EG(persistent_list), (void**) &le, &pos) == SUCCESS) {
+    if (le->type == le_cassandra_session_res &&
+        zend_hash_get_current_key_ex(&EG(persistent_list), &key, &key_len, &index, 0, &pos) == HASH_KEY_IS_STRING) {
+      cassandra_psession* psession = (cassandra_psession*) le->ptr;
+      /* Only print the keyspace, the cluster part of the key contains credentials */
+      const char* keyspace = strstr(key, ":session:");
+
+      keyspace = keyspace ? keyspace + sizeof(":session:") - 1 : "";
+      snprintf(title, sizeof(title), "Persistent Session (keyspace: %s)",
+               *keyspace ? keyspace : "none");
+      php_cassandra_print_metrics(psession->session, title);
+    }
+
+    zend_hash_move_forward_ex(&EG(persistent_list), &pos);
+  }
+}
+
 PHP_MINFO_FUNCTION(cassandra)
 {
   char buf[256];
@@ -485,6 +597,8 @@ PHP_MINFO_FUNCTION(cassandra)
 
   php_info_print_table_end();
 
+  php_cassandra_print_persistent_sessions_metrics(TSRMLS_C);
+
   DISPLAY_INI_ENTRIES();
 }
 
@@ -71,6 +71,8 @@ extern zend_module_entry cassandra_module_entry;
 
 zend_class_entry* exception_class(CassError rc);
 
+void php_cassandra_log_line(const char* severity, const char* message);
+
 void throw_invalid_argument(zval* object,
                             const char* object_name,
                             const char* expected_type TSRMLS_DC);
@@ -118,6 +120,18 @@ ZEND_BEGIN_MODULE_GLOBALS(cassandra)
   CassUuidGen*          uuid_gen;
   unsigned int          persistent_clusters;
   unsigned int          persistent_sessions;
+  zend_bool             execution_info;
+  zend_bool             metrics;
+  long                  slow_query_threshold_ms;
+  zend_bool             slow_query_log_arguments;
+  long                  stats_size;
+  long                  stats_dump_interval;
+  long                  stats_dump_top;
+  char*                 record_results;
+  char*                 sessions;
+  zend_bool             sessions_prewarmed;
+  long                  max_persistent_sessions;
+  zend_bool             rate_limit_shared;
   zval*                 type_varchar;
   zval*                 type_text;
   zval*                 type_blob;
@@ -134,6 +148,7 @@ ZEND_BEGIN_MODULE_GLOBALS(cassandra)
   zval*                 type_timestamp;
   zval*                 type_uuid;
   zval*                 type_timeuuid;
+  HashTable*            type_registry;
 ZEND_END_MODULE_GLOBALS(cassandra)
 
 #ifdef ZTS
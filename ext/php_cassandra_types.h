@@ -81,6 +81,15 @@ typedef struct {
   HashTable values;
 } cassandra_collection;
 
+typedef struct {
+  long requests_per_second;
+  long bytes_per_second;
+  cass_bool_t fail_fast;
+  /* Token buckets, NULL when not limited */
+  volatile cass_uint64_t* requests;
+  volatile cass_uint64_t* bytes;
+} cassandra_rate_limit;
+
 typedef struct {
   zend_object zval;
   CassCluster* cluster;
@@ -90,12 +99,15 @@ typedef struct {
   cass_bool_t persist;
   char* hash_key;
   int hash_key_len;
+  cassandra_rate_limit rate_limit;
+  zval* profiles;
 } cassandra_cluster;
 
 typedef enum {
   CASSANDRA_SIMPLE_STATEMENT,
   CASSANDRA_PREPARED_STATEMENT,
-  CASSANDRA_BATCH_STATEMENT
+  CASSANDRA_BATCH_STATEMENT,
+  CASSANDRA_BOUND_STATEMENT
 } cassandra_statement_type;
 
 #define STATEMENT_FIELDS \
@@ -114,8 +126,18 @@ typedef struct {
 typedef struct {
   STATEMENT_FIELDS
   const CassPrepared* prepared;
+  char* cql;
+  HashTable* parameters;
+  size_t* parameters_next;
 } cassandra_prepared_statement;
 
+typedef struct {
+  STATEMENT_FIELDS
+  zval* prepared_statement;
+  zval* arguments;
+  CassStatement* statement;
+} cassandra_bound_statement;
+
 typedef struct {
   STATEMENT_FIELDS
   CassBatchType batch_type;
@@ -136,6 +158,10 @@ typedef struct {
   int page_size;
   zval* timeout;
   zval* arguments;
+  int idempotent;
+  zval* retry_policy;
+  char* profile;
+  int profile_len;
 } cassandra_execution_options;
 
 typedef enum {
@@ -151,6 +177,31 @@ typedef struct {
   void*                   data;
 } cassandra_ref;
 
+typedef struct {
+  cass_uint64_t requests;
+  cass_uint64_t request_errors;
+  cass_uint64_t binding_errors;
+  cass_uint64_t prepared_statements;
+  cass_uint64_t decoded_rows;
+  cass_uint64_t decoded_bytes;
+  cass_uint64_t decode_time;
+} cassandra_counters;
+
+typedef struct {
+  cass_uint64_t bind_start;
+  cass_uint64_t bind_end;
+  cass_uint64_t submit;
+  cass_uint64_t response;
+  cass_uint64_t decode_end;
+  size_t result_size;
+  size_t row_count;
+  /* Only kept while the slow query log is enabled */
+  zval* statement;
+  zval* arguments;
+  long consistency;
+  long page_size;
+} cassandra_execution_info;
+
 typedef struct {
   zend_object zval;
   cassandra_ref* statement;
@@ -159,6 +210,9 @@ typedef struct {
   const CassResult* result;
   zval* next_page;
   zval* future_next_page;
+  cassandra_execution_info* info;
+  /* Estimated size of the request, charged again for every page */
+  size_t request_size;
 } cassandra_rows;
 
 typedef struct {
@@ -167,6 +221,8 @@ typedef struct {
   zval* session;
   zval* rows;
   CassFuture* future;
+  cassandra_execution_info* info;
+  size_t request_size;
 } cassandra_future_rows;
 
 typedef struct {
@@ -183,6 +239,7 @@ typedef struct {
   unsigned int connect_timeout;
   unsigned int request_timeout;
   zval* ssl_options;
+  zval* retry_policy;
   long default_consistency;
   int default_page_size;
   zval* default_timeout;
@@ -196,12 +253,20 @@ typedef struct {
   cass_bool_t enable_tcp_nodelay;
   cass_bool_t enable_tcp_keepalive;
   unsigned int tcp_keepalive_delay;
+  cass_bool_t enable_schema;
+  unsigned int speculative_delay;
+  int speculative_max_executions;
+  long rate_limit_requests;
+  long rate_limit_bytes;
+  cass_bool_t rate_limit_fail_fast;
+  zval* profiles;
 } cassandra_cluster_builder;
 
 typedef struct {
   zend_object zval;
   CassFuture* future;
   zval* prepared_statement;
+  char* cql;
 } cassandra_future_prepared_statement;
 
 typedef struct {
@@ -214,6 +279,24 @@ typedef struct {
   CassFuture* future;
 } cassandra_future_close;
 
+typedef struct {
+  CassFuture* future;
+  CassSession* session;
+  /* Not owned: persistent sessions are only created for persistent
+   * clusters, which stay in the persistent list until module shutdown and
+   * are destroyed after the sessions connected after them. */
+  CassCluster* cluster;
+  /* Session replaced by a rebuild, freed once it is closed */
+  CassSession* closing;
+  CassFuture* close_future;
+  char* keyspace;
+  unsigned long last_used;
+  char* error;
+  CassError error_code;
+  cass_bool_t rebuild;
+  cass_uint64_t checked_at;
+} cassandra_psession;
+
 typedef struct {
   zend_object zval;
   CassFuture* future;
@@ -224,13 +307,11 @@ typedef struct {
   int hash_key_len;
   char* exception_message;
   CassError exception_code;
+  cassandra_psession* psession;
+  cassandra_rate_limit rate_limit;
+  zval* profiles;
 } cassandra_future_session;
 
-typedef struct {
-  CassFuture* future;
-  CassSession* session;
-} cassandra_psession;
-
 typedef struct {
   zend_object zval;
   CassSession* session;
@@ -238,6 +319,10 @@ typedef struct {
   int default_page_size;
   zval* default_timeout;
   cass_bool_t persist;
+  cassandra_ref* schema;
+  cassandra_psession* psession;
+  cassandra_rate_limit rate_limit;
+  zval* profiles;
 } cassandra_session;
 
 typedef struct {
@@ -245,6 +330,12 @@ typedef struct {
   CassSsl* ssl;
 } cassandra_ssl;
 
+typedef struct {
+  zend_object zval;
+  CassRetryPolicy* policy;
+  char* name;
+} cassandra_retry_policy;
+
 typedef struct {
   zend_object zval;
   int flags;
@@ -255,6 +346,17 @@ typedef struct {
   char* passphrase;
 } cassandra_ssl_builder;
 
+#if CURRENT_CPP_DRIVER_VERSION >= CPP_DRIVER_VERSION(2, 2, 0)
+typedef const CassSchemaMeta cassandra_schema_meta;
+#else
+typedef const CassSchema cassandra_schema_meta;
+#endif
+
+typedef struct {
+  cassandra_schema_meta* meta;
+  HashTable column_types;
+} cassandra_schema_snapshot;
+
 typedef struct {
   zend_object zval;
   cassandra_ref* schema;
@@ -430,9 +532,18 @@ extern PHP_CASSANDRA_API zend_class_entry* cassandra_range_exception_ce;
 extern PHP_CASSANDRA_API zend_class_entry* cassandra_statement_ce;
 extern PHP_CASSANDRA_API zend_class_entry* cassandra_simple_statement_ce;
 extern PHP_CASSANDRA_API zend_class_entry* cassandra_prepared_statement_ce;
+extern PHP_CASSANDRA_API zend_class_entry* cassandra_bound_statement_ce;
 extern PHP_CASSANDRA_API zend_class_entry* cassandra_batch_statement_ce;
 extern PHP_CASSANDRA_API zend_class_entry* cassandra_execution_options_ce;
 extern PHP_CASSANDRA_API zend_class_entry* cassandra_rows_ce;
+extern PHP_CASSANDRA_API zend_class_entry* cassandra_stats_ce;
+extern PHP_CASSANDRA_API zend_class_entry* cassandra_recording_ce;
+extern PHP_CASSANDRA_API zend_class_entry* cassandra_metrics_ce;
+extern PHP_CASSANDRA_API zend_class_entry* cassandra_retry_policy_ce;
+extern PHP_CASSANDRA_API zend_class_entry* cassandra_retry_policy_default_ce;
+extern PHP_CASSANDRA_API zend_class_entry* cassandra_retry_policy_downgrading_consistency_ce;
+extern PHP_CASSANDRA_API zend_class_entry* cassandra_retry_policy_fallthrough_ce;
+extern PHP_CASSANDRA_API zend_class_entry* cassandra_retry_policy_logging_ce;
 
 void cassandra_define_Cassandra(TSRMLS_D);
 void cassandra_define_Cluster(TSRMLS_D);
@@ -451,9 +562,18 @@ void cassandra_define_SSLOptionsBuilder(TSRMLS_D);
 void cassandra_define_Statement(TSRMLS_D);
 void cassandra_define_SimpleStatement(TSRMLS_D);
 void cassandra_define_PreparedStatement(TSRMLS_D);
+void cassandra_define_BoundStatement(TSRMLS_D);
 void cassandra_define_BatchStatement(TSRMLS_D);
 void cassandra_define_ExecutionOptions(TSRMLS_D);
 void cassandra_define_Rows(TSRMLS_D);
+void cassandra_define_Stats(TSRMLS_D);
+void cassandra_define_Recording(TSRMLS_D);
+void cassandra_define_Metrics(TSRMLS_D);
+void cassandra_define_RetryPolicy(TSRMLS_D);
+void cassandra_define_RetryPolicyDefault(TSRMLS_D);
+void cassandra_define_RetryPolicyDowngradingConsistency(TSRMLS_D);
+void cassandra_define_RetryPolicyFallthrough(TSRMLS_D);
+void cassandra_define_RetryPolicyLogging(TSRMLS_D);
 
 extern PHP_CASSANDRA_API zend_class_entry* cassandra_schema_ce;
 extern PHP_CASSANDRA_API zend_class_entry* cassandra_default_schema_ce;
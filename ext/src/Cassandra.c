@@ -1,4 +1,7 @@
 #include "php_cassandra.h"
+#include "util/future.h"
+#include "util/prewarm.h"
+#include "util/psession.h"
 
 zend_class_entry* cassandra_ce = NULL;
 
@@ -12,12 +15,50 @@ PHP_METHOD(Cassandra, ssl)
   object_init_ex(return_value, cassandra_ssl_builder_ce);
 }
 
+PHP_METHOD(Cassandra, session)
+{
+  char* name;
+  int   name_len;
+  zval* timeout = NULL;
+  cassandra_psession* psession;
+  cassandra_session* session;
+
+  if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "s|z", &name, &name_len, &timeout) == FAILURE) {
+    return;
+  }
+
+  psession = php_cassandra_prewarm_session(name, name_len TSRMLS_CC);
+  if (!psession)
+    return;
+
+  object_init_ex(return_value, cassandra_default_session_ce);
+  session = (cassandra_session*) zend_object_store_get_object(return_value TSRMLS_CC);
+
+  session->session  = psession->session;
+  session->psession = psession;
+  session->persist  = 1;
+
+  if (php_cassandra_future_wait_timed(psession->future, timeout TSRMLS_CC) == FAILURE)
+    return;
+
+  if (php_cassandra_future_is_error(psession->future TSRMLS_CC) == FAILURE) {
+    /* Rebuilt at the end of the request, failing fast until then */
+    php_cassandra_psession_failed(psession, psession->future);
+  }
+}
+
 ZEND_BEGIN_ARG_INFO_EX(arginfo_none, 0, ZEND_RETURN_VALUE, 0)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_session, 0, ZEND_RETURN_VALUE, 1)
+  ZEND_ARG_INFO(0, name)
+  ZEND_ARG_INFO(0, timeout)
+ZEND_END_ARG_INFO()
+
 static zend_function_entry Cassandra_methods[] = {
   PHP_ME(Cassandra, cluster, arginfo_none,  ZEND_ACC_PUBLIC|ZEND_ACC_STATIC)
   PHP_ME(Cassandra, ssl,     arginfo_none,  ZEND_ACC_PUBLIC|ZEND_ACC_STATIC)
+  PHP_ME(Cassandra, session, arginfo_session, ZEND_ACC_PUBLIC|ZEND_ACC_STATIC)
   PHP_FE_END
 };
 
@@ -57,8 +57,10 @@ PHP_METHOD(BatchStatement, add)
   }
 
   if (!instanceof_function(Z_OBJCE_P(statement), cassandra_simple_statement_ce TSRMLS_CC) &&
-      !instanceof_function(Z_OBJCE_P(statement), cassandra_prepared_statement_ce TSRMLS_CC)) {
-    INVALID_ARGUMENT(statement, "an instance of Cassandra\\SimpleStatement or Cassandra\\PreparedStatement");
+      !instanceof_function(Z_OBJCE_P(statement), cassandra_prepared_statement_ce TSRMLS_CC) &&
+      !instanceof_function(Z_OBJCE_P(statement), cassandra_bound_statement_ce TSRMLS_CC)) {
+    INVALID_ARGUMENT(statement, "an instance of Cassandra\\SimpleStatement, " \
+                                "Cassandra\\PreparedStatement or Cassandra\\BoundStatement");
   }
 
   entry = (cassandra_batch_statement_entry*) ecalloc(1, sizeof(cassandra_batch_statement_entry));
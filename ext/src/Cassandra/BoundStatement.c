@@ -0,0 +1,305 @@
+#include "php_cassandra.h"
+#include "util/bind.h"
+#include "util/metrics.h"
+#include "src/Cassandra/BoundStatement.h"
+#include "src/Cassandra/PreparedStatement.h"
+
+zend_class_entry *cassandra_bound_statement_ce = NULL;
+
+ZEND_EXTERN_MODULE_GLOBALS(cassandra)
+
+/* Binds a new driver statement with all the values bound so far. */
+CassStatement*
+php_cassandra_bound_statement_build(cassandra_bound_statement* statement TSRMLS_DC)
+{
+  cassandra_prepared_statement* prepared =
+    (cassandra_prepared_statement*) zend_object_store_get_object(statement->prepared_statement TSRMLS_CC);
+  CassStatement* cass_statement = cass_prepared_bind(prepared->prepared);
+
+  if (statement->arguments &&
+      php_cassandra_bind_arguments(cass_statement, prepared,
+                                   Z_ARRVAL_P(statement->arguments) TSRMLS_CC) == FAILURE) {
+    cass_statement_free(cass_statement);
+    return NULL;
+  }
+
+  return cass_statement;
+}
+
+/* Takes the driver statement for an execution. It is only rebuilt when a
+ * previous execution handed it over to its result for paging. */
+CassStatement*
+php_cassandra_bound_statement_acquire(cassandra_bound_statement* statement TSRMLS_DC)
+{
+  CassStatement* cass_statement = statement->statement;
+
+  if (!cass_statement)
+    return php_cassandra_bound_statement_build(statement TSRMLS_CC);
+
+  statement->statement = NULL;
+  return cass_statement;
+}
+
+/* Gives the driver statement back once the driver is done with it. */
+void
+php_cassandra_bound_statement_release(cassandra_bound_statement* statement,
+                                      CassStatement* cass_statement)
+{
+  if (statement->statement)
+    cass_statement_free(statement->statement);
+
+  statement->statement = cass_statement;
+}
+
+static void
+php_cassandra_bound_statement_store(HashTable* arguments, const char* name,
+                                    size_t name_length, ulong index, zval* value)
+{
+  Z_ADDREF_P(value);
+
+  /* Moved to the end, so that a rebuild binds the values in the order they
+   * were given. Names don't go through the symtable, "0" is not index 0. */
+  if (name) {
+    zend_hash_del(arguments, name, name_length + 1);
+    zend_hash_update(arguments, name, name_length + 1, &value, sizeof(zval*), NULL);
+  } else {
+    zend_hash_index_del(arguments, index);
+    zend_hash_index_update(arguments, index, &value, sizeof(zval*), NULL);
+  }
+}
+
+/* Remembers a bound value to bind it again when the driver statement is
+ * rebuilt. Names are resolved to the indices of their parameters, so a
+ * value replaces the previous one whether it was bound by index or by any
+ * spelling of the name. Names are only kept as given when the statement
+ * has no map of its parameters or they match none, binding them fails. */
+static void
+php_cassandra_bound_statement_remember(cassandra_bound_statement* statement,
+                                       cassandra_prepared_statement* prepared,
+                                       const char* name, size_t name_length,
+                                       ulong index, zval* value)
+{
+  size_t parameter;
+
+  if (!statement->arguments) {
+    MAKE_STD_ZVAL(statement->arguments);
+    array_init(statement->arguments);
+  }
+
+  if (name && prepared->parameters &&
+      php_cassandra_prepared_statement_parameter(prepared, name, name_length,
+                                                 &parameter) == SUCCESS) {
+    do {
+      php_cassandra_bound_statement_store(Z_ARRVAL_P(statement->arguments),
+                                          NULL, 0, parameter, value);
+      parameter = prepared->parameters_next[parameter];
+    } while (parameter);
+    return;
+  }
+
+  php_cassandra_bound_statement_store(Z_ARRVAL_P(statement->arguments),
+                                      name, name_length, index, value);
+}
+
+PHP_METHOD(BoundStatement, __construct)
+{
+  zval* prepared_statement = NULL;
+  zval* arguments = NULL;
+  cassandra_bound_statement* self = NULL;
+  cassandra_prepared_statement* prepared = NULL;
+  HashPosition pos;
+  zval** value;
+  char* key;
+  uint key_length;
+  ulong index;
+
+  if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "O|a", &prepared_statement,
+                            cassandra_prepared_statement_ce, &arguments) == FAILURE) {
+    return;
+  }
+
+  self = (cassandra_bound_statement*) zend_object_store_get_object(getThis() TSRMLS_CC);
+
+  self->prepared_statement = prepared_statement;
+  Z_ADDREF_P(self->prepared_statement);
+
+  prepared = (cassandra_prepared_statement*) zend_object_store_get_object(prepared_statement TSRMLS_CC);
+
+  if (arguments) {
+    zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(arguments), &pos);
+    while (zend_hash_get_current_data_ex(Z_ARRVAL_P(arguments), (void**) &value, &pos) == SUCCESS) {
+      if (zend_hash_get_current_key_ex(Z_ARRVAL_P(arguments), &key, &key_length,
+                                       &index, 0, &pos) == HASH_KEY_IS_STRING)
+        php_cassandra_bound_statement_remember(self, prepared, key, key_length - 1, 0, *value);
+      else
+        php_cassandra_bound_statement_remember(self, prepared, NULL, 0, index, *value);
+
+      zend_hash_move_forward_ex(Z_ARRVAL_P(arguments), &pos);
+    }
+  }
+
+  self->statement = php_cassandra_bound_statement_build(self TSRMLS_CC);
+
+  if (!self->statement) {
+    PHP_CASSANDRA_COUNTER_ADD(binding_errors, 1);
+
+    if (!EG(exception))
+      INVALID_ARGUMENT(arguments, "an array of values of supported types");
+  }
+}
+
+PHP_METHOD(BoundStatement, bind)
+{
+  zval* name = NULL;
+  zval* value = NULL;
+  cassandra_bound_statement* self = NULL;
+  cassandra_prepared_statement* prepared = NULL;
+  int rc;
+
+  if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "zz", &name, &value) == FAILURE) {
+    return;
+  }
+
+  if (Z_TYPE_P(name) == IS_LONG) {
+    if (Z_LVAL_P(name) < 0) {
+      INVALID_ARGUMENT(name, "a positive integer or a string");
+    }
+  } else if (Z_TYPE_P(name) != IS_STRING) {
+    INVALID_ARGUMENT(name, "a positive integer or a string");
+  }
+
+  self     = (cassandra_bound_statement*) zend_object_store_get_object(getThis() TSRMLS_CC);
+  prepared = (cassandra_prepared_statement*) zend_object_store_get_object(self->prepared_statement TSRMLS_CC);
+
+  if (!self->statement) {
+    self->statement = php_cassandra_bound_statement_build(self TSRMLS_CC);
+
+    if (!self->statement) {
+      PHP_CASSANDRA_COUNTER_ADD(binding_errors, 1);
+      return;
+    }
+  }
+
+  /* Only the given value is bound, the others stay as they are */
+  if (Z_TYPE_P(name) == IS_STRING)
+    rc = php_cassandra_bind_argument_by_parameter(self->statement, prepared, Z_STRVAL_P(name),
+                                                  Z_STRLEN_P(name), value TSRMLS_CC);
+  else
+    rc = php_cassandra_bind_argument_by_index(self->statement, (size_t) Z_LVAL_P(name), value TSRMLS_CC);
+
+  if (rc == FAILURE) {
+    PHP_CASSANDRA_COUNTER_ADD(binding_errors, 1);
+
+    if (!EG(exception))
+      INVALID_ARGUMENT(value, "a value of a supported type");
+
+    return;
+  }
+
+  if (Z_TYPE_P(name) == IS_STRING)
+    php_cassandra_bound_statement_remember(self, prepared, Z_STRVAL_P(name),
+                                           Z_STRLEN_P(name), 0, value);
+  else
+    php_cassandra_bound_statement_remember(self, prepared, NULL, 0,
+                                           (ulong) Z_LVAL_P(name), value);
+
+  RETURN_ZVAL(getThis(), 1, 0);
+}
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo__construct, 0, ZEND_RETURN_VALUE, 1)
+  ZEND_ARG_OBJ_INFO(0, statement, Cassandra\\PreparedStatement, 0)
+  ZEND_ARG_ARRAY_INFO(0, arguments, 1)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_bind, 0, ZEND_RETURN_VALUE, 2)
+  ZEND_ARG_INFO(0, name)
+  ZEND_ARG_INFO(0, value)
+ZEND_END_ARG_INFO()
+
+static zend_function_entry cassandra_bound_statement_methods[] = {
+  PHP_ME(BoundStatement, __construct, arginfo__construct, ZEND_ACC_PUBLIC | ZEND_ACC_CTOR)
+  PHP_ME(BoundStatement, bind, arginfo_bind, ZEND_ACC_PUBLIC)
+  PHP_FE_END
+};
+
+static zend_object_handlers cassandra_bound_statement_handlers;
+
+static HashTable*
+php_cassandra_bound_statement_properties(zval *object TSRMLS_DC)
+{
+  HashTable* props = zend_std_get_properties(object TSRMLS_CC);
+
+  return props;
+}
+
+static int
+php_cassandra_bound_statement_compare(zval *obj1, zval *obj2 TSRMLS_DC)
+{
+  if (Z_OBJCE_P(obj1) != Z_OBJCE_P(obj2))
+    return 1; /* different classes */
+
+  return Z_OBJ_HANDLE_P(obj1) != Z_OBJ_HANDLE_P(obj2);
+}
+
+static void
+php_cassandra_bound_statement_free(void *object TSRMLS_DC)
+{
+  cassandra_bound_statement* statement = (cassandra_bound_statement*) object;
+
+  if (statement->statement) {
+    cass_statement_free(statement->statement);
+    statement->statement = NULL;
+  }
+
+  if (statement->arguments) {
+    zval_ptr_dtor(&statement->arguments);
+    statement->arguments = NULL;
+  }
+
+  if (statement->prepared_statement) {
+    zval_ptr_dtor(&statement->prepared_statement);
+    statement->prepared_statement = NULL;
+  }
+
+  zend_object_std_dtor(&statement->zval TSRMLS_CC);
+  efree(statement);
+}
+
+static zend_object_value
+php_cassandra_bound_statement_new(zend_class_entry* class_type TSRMLS_DC)
+{
+  zend_object_value retval;
+  cassandra_bound_statement *statement;
+
+  statement = (cassandra_bound_statement*) ecalloc(1, sizeof(cassandra_bound_statement));
+
+  zend_object_std_init(&statement->zval, class_type TSRMLS_CC);
+  object_properties_init(&statement->zval, class_type);
+
+  statement->type               = CASSANDRA_BOUND_STATEMENT;
+  statement->prepared_statement = NULL;
+  statement->arguments          = NULL;
+  statement->statement          = NULL;
+
+  retval.handle   = zend_objects_store_put(statement,
+                      (zend_objects_store_dtor_t) zend_objects_destroy_object,
+                      php_cassandra_bound_statement_free, NULL TSRMLS_CC);
+  retval.handlers = &cassandra_bound_statement_handlers;
+
+  return retval;
+}
+
+void cassandra_define_BoundStatement(TSRMLS_D)
+{
+  zend_class_entry ce;
+
+  INIT_CLASS_ENTRY(ce, "Cassandra\\BoundStatement", cassandra_bound_statement_methods);
+  cassandra_bound_statement_ce = zend_register_internal_class(&ce TSRMLS_CC);
+  zend_class_implements(cassandra_bound_statement_ce TSRMLS_CC, 1, cassandra_statement_ce);
+  cassandra_bound_statement_ce->ce_flags     |= ZEND_ACC_FINAL_CLASS;
+  cassandra_bound_statement_ce->create_object = php_cassandra_bound_statement_new;
+
+  memcpy(&cassandra_bound_statement_handlers, zend_get_std_object_handlers(), sizeof(zend_object_handlers));
+  cassandra_bound_statement_handlers.get_properties  = php_cassandra_bound_statement_properties;
+  cassandra_bound_statement_handlers.compare_objects = php_cassandra_bound_statement_compare;
+}
@@ -0,0 +1,9 @@
+#ifndef PHP_CASSANDRA_BOUND_STATEMENT_H
+#define PHP_CASSANDRA_BOUND_STATEMENT_H
+
+CassStatement* php_cassandra_bound_statement_build(cassandra_bound_statement* statement TSRMLS_DC);
+CassStatement* php_cassandra_bound_statement_acquire(cassandra_bound_statement* statement TSRMLS_DC);
+void           php_cassandra_bound_statement_release(cassandra_bound_statement* statement,
+                                                     CassStatement* cass_statement);
+
+#endif /* PHP_CASSANDRA_BOUND_STATEMENT_H */
@@ -1,5 +1,6 @@
 #include "php_cassandra.h"
 #include "util/consistency.h"
+#include "util/rate_limit.h"
 #include <ext/standard/php_smart_str.h>
 
 zend_class_entry *cassandra_cluster_builder_ce = NULL;
@@ -10,6 +11,7 @@ PHP_METHOD(ClusterBuilder, build)
 {
   char* hash_key;
   int   hash_key_len = 0;
+  cassandra_retry_policy* retry_policy = NULL;
   cassandra_cluster* cluster = NULL;
 
   cassandra_cluster_builder* builder =
@@ -27,11 +29,33 @@ PHP_METHOD(ClusterBuilder, build)
     Z_ADDREF_P(cluster->default_timeout);
   }
 
+  if (builder->profiles) {
+    cluster->profiles = builder->profiles;
+    Z_ADDREF_P(cluster->profiles);
+  }
+
+  if (builder->retry_policy) {
+    retry_policy = (cassandra_retry_policy*)
+      zend_object_store_get_object(builder->retry_policy TSRMLS_CC);
+  }
+
+  if (builder->rate_limit_requests > 0 || builder->rate_limit_bytes > 0) {
+    char* rate_limit_key;
+
+    /* Clusters with the same contact points and limits share their buckets */
+    spprintf(&rate_limit_key, 0, "%s:%d", builder->contact_points, builder->port);
+    php_cassandra_rate_limit_init(&cluster->rate_limit, rate_limit_key,
+                                  builder->rate_limit_requests,
+                                  builder->rate_limit_bytes,
+                                  builder->rate_limit_fail_fast TSRMLS_CC);
+    efree(rate_limit_key);
+  }
+
   if (builder->persist) {
     zend_rsrc_list_entry *le;
 
     hash_key_len = spprintf(&hash_key, 0,
-      "cassandra:%s:%d:%d:%s:%d:%d:%d:%s:%s:%d:%d:%d:%d:%d:%d:%d:%d:%d:%d:%d",
+      "cassandra:%s:%d:%d:%s:%d:%d:%d:%s:%s:%d:%d:%d:%d:%d:%d:%d:%d:%d:%d:%d:%d:%d:%d:%s",
       builder->contact_points, builder->port, builder->load_balancing_policy,
       SAFE_STR(builder->local_dc), builder->used_hosts_per_remote_dc,
       builder->allow_remote_dcs_for_local_cl, builder->use_token_aware_routing,
@@ -41,7 +65,9 @@ PHP_METHOD(ClusterBuilder, build)
       builder->core_connections_per_host, builder->max_connections_per_host,
       builder->reconnect_interval, builder->enable_latency_aware_routing,
       builder->enable_tcp_nodelay, builder->enable_tcp_keepalive,
-      builder->tcp_keepalive_delay);
+      builder->tcp_keepalive_delay, builder->enable_schema,
+      builder->speculative_delay, builder->speculative_max_executions,
+      retry_policy ? SAFE_STR(retry_policy->name) : "");
 
     cluster->hash_key     = hash_key;
     cluster->hash_key_len = hash_key_len;
@@ -79,6 +105,10 @@ PHP_METHOD(ClusterBuilder, build)
     cass_cluster_set_ssl(cluster->cluster, options->ssl);
   }
 
+  if (retry_policy && retry_policy->policy) {
+    cass_cluster_set_retry_policy(cluster->cluster, retry_policy->policy);
+  }
+
   ASSERT_SUCCESS(cass_cluster_set_contact_points(cluster->cluster, builder->contact_points));
   ASSERT_SUCCESS(cass_cluster_set_port(cluster->cluster, builder->port));
 
@@ -90,6 +120,15 @@ PHP_METHOD(ClusterBuilder, build)
   cass_cluster_set_latency_aware_routing(cluster->cluster, builder->enable_latency_aware_routing);
   cass_cluster_set_tcp_nodelay(cluster->cluster, builder->enable_tcp_nodelay);
   cass_cluster_set_tcp_keepalive(cluster->cluster, builder->enable_tcp_keepalive, builder->tcp_keepalive_delay);
+#if CURRENT_CPP_DRIVER_VERSION >= CPP_DRIVER_VERSION(2, 3, 0)
+  cass_cluster_set_use_schema(cluster->cluster, builder->enable_schema);
+#endif
+#if CURRENT_CPP_DRIVER_VERSION >= CPP_DRIVER_VERSION(2, 7, 0)
+  if (builder->speculative_max_executions > 0) {
+    ASSERT_SUCCESS(cass_cluster_set_constant_speculative_execution_policy(cluster->cluster,
+      builder->speculative_delay, builder->speculative_max_executions));
+  }
+#endif
 
   if (builder->persist) {
     zend_rsrc_list_entry le;
@@ -386,6 +425,93 @@ PHP_METHOD(ClusterBuilder, withSSL)
   RETURN_ZVAL(getThis(), 1, 0);
 }
 
+PHP_METHOD(ClusterBuilder, withRetryPolicy)
+{
+  zval *retry_policy;
+  cassandra_cluster_builder* builder = NULL;
+
+  if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "O", &retry_policy, cassandra_retry_policy_ce) == FAILURE) {
+    return;
+  }
+
+  builder = (cassandra_cluster_builder*) zend_object_store_get_object(getThis() TSRMLS_CC);
+
+  if (builder->retry_policy)
+    zval_ptr_dtor(&builder->retry_policy);
+
+  Z_ADDREF_P(retry_policy);
+  builder->retry_policy = retry_policy;
+
+  RETURN_ZVAL(getThis(), 1, 0);
+}
+
+PHP_METHOD(ClusterBuilder, withRateLimit)
+{
+  zval* requests;
+  zval* bytes = NULL;
+  zend_bool fail_fast = 0;
+  cassandra_cluster_builder* builder = NULL;
+
+  if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z|zb", &requests, &bytes, &fail_fast) == FAILURE) {
+    return;
+  }
+
+  builder = (cassandra_cluster_builder*) zend_object_store_get_object(getThis() TSRMLS_CC);
+
+  if (!(Z_TYPE_P(requests) == IS_LONG && Z_LVAL_P(requests) > 0) &&
+      Z_TYPE_P(requests) != IS_NULL) {
+    INVALID_ARGUMENT(requests, "a positive integer or null");
+  }
+
+  if (bytes && !(Z_TYPE_P(bytes) == IS_LONG && Z_LVAL_P(bytes) > 0) &&
+      Z_TYPE_P(bytes) != IS_NULL) {
+    INVALID_ARGUMENT(bytes, "a positive integer or null");
+  }
+
+  builder->rate_limit_requests  = Z_TYPE_P(requests) == IS_LONG ? Z_LVAL_P(requests) : 0;
+  builder->rate_limit_bytes     = bytes && Z_TYPE_P(bytes) == IS_LONG ? Z_LVAL_P(bytes) : 0;
+  builder->rate_limit_fail_fast = fail_fast;
+
+  RETURN_ZVAL(getThis(), 1, 0);
+}
+
+PHP_METHOD(ClusterBuilder, withExecutionProfile)
+{
+  char* name;
+  int   name_len;
+  zval* options;
+  cassandra_execution_options* opts = NULL;
+  cassandra_cluster_builder* builder = NULL;
+
+  if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "sO", &name, &name_len,
+                            &options, cassandra_execution_options_ce) == FAILURE) {
+    return;
+  }
+
+  builder = (cassandra_cluster_builder*) zend_object_store_get_object(getThis() TSRMLS_CC);
+  opts    = (cassandra_execution_options*) zend_object_store_get_object(options TSRMLS_CC);
+
+  if (opts->arguments || opts->profile) {
+    zend_throw_exception_ex(cassandra_invalid_argument_exception_ce, 0 TSRMLS_CC,
+                            "Execution profile \"%s\" cannot contain arguments or a profile",
+                            name);
+    return;
+  }
+
+  if (!builder->profiles) {
+    MAKE_STD_ZVAL(builder->profiles);
+    array_init(builder->profiles);
+  } else {
+    /* Clusters that were already built keep their profiles */
+    SEPARATE_ZVAL(&builder->profiles);
+  }
+
+  Z_ADDREF_P(options);
+  add_assoc_zval_ex(builder->profiles, name, name_len + 1, options);
+
+  RETURN_ZVAL(getThis(), 1, 0);
+}
+
 PHP_METHOD(ClusterBuilder, withPersistentSessions)
 {
   zend_bool enabled = 1;
@@ -531,6 +657,22 @@ PHP_METHOD(ClusterBuilder, withTCPNodelay)
   RETURN_ZVAL(getThis(), 1, 0);
 }
 
+PHP_METHOD(ClusterBuilder, withSchemaMetadata)
+{
+  zend_bool enabled = 1;
+  cassandra_cluster_builder* builder = NULL;
+
+  if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "|b", &enabled) == FAILURE) {
+    return;
+  }
+
+  builder = (cassandra_cluster_builder*) zend_object_store_get_object(getThis() TSRMLS_CC);
+
+  builder->enable_schema = enabled;
+
+  RETURN_ZVAL(getThis(), 1, 0);
+}
+
 PHP_METHOD(ClusterBuilder, withTCPKeepalive)
 {
   zval* delay;
@@ -558,6 +700,55 @@ PHP_METHOD(ClusterBuilder, withTCPKeepalive)
   RETURN_ZVAL(getThis(), 1, 0);
 }
 
+PHP_METHOD(ClusterBuilder, withSpeculativeExecution)
+{
+  zval* delay;
+  zval* max_executions = NULL;
+  unsigned int delay_ms = 0;
+  cassandra_cluster_builder* builder = NULL;
+
+  if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z|z", &delay, &max_executions) == FAILURE) {
+    return;
+  }
+
+  builder = (cassandra_cluster_builder*) zend_object_store_get_object(getThis() TSRMLS_CC);
+
+  if (Z_TYPE_P(delay) == IS_NULL) {
+    builder->speculative_delay          = 0;
+    builder->speculative_max_executions = 0;
+    RETURN_ZVAL(getThis(), 1, 0);
+  }
+
+#if CURRENT_CPP_DRIVER_VERSION < CPP_DRIVER_VERSION(2, 7, 0)
+  zend_throw_exception_ex(cassandra_runtime_exception_ce, 0 TSRMLS_CC,
+    "Speculative execution requires version 2.7.0 or later of the C/C++ driver");
+  return;
+#endif
+
+  /* The driver takes the delay in milliseconds as an unsigned int */
+  if (Z_TYPE_P(delay) == IS_LONG && Z_LVAL_P(delay) >= 0 &&
+      Z_LVAL_P(delay) <= UINT_MAX / 1000) {
+    delay_ms = Z_LVAL_P(delay) * 1000;
+  } else if (Z_TYPE_P(delay) == IS_DOUBLE && Z_DVAL_P(delay) >= 0 &&
+             Z_DVAL_P(delay) <= UINT_MAX / 1000) {
+    delay_ms = ceil(Z_DVAL_P(delay) * 1000);
+  } else {
+    INVALID_ARGUMENT(delay, "a number of seconds between 0 and 4294967 or null");
+  }
+
+  if (max_executions == NULL) {
+    builder->speculative_max_executions = 1;
+  } else if (Z_TYPE_P(max_executions) == IS_LONG && Z_LVAL_P(max_executions) > 0) {
+    builder->speculative_max_executions = Z_LVAL_P(max_executions);
+  } else {
+    INVALID_ARGUMENT(max_executions, "a positive integer");
+  }
+
+  builder->speculative_delay = delay_ms;
+
+  RETURN_ZVAL(getThis(), 1, 0);
+}
+
 ZEND_BEGIN_ARG_INFO_EX(arginfo_none, 0, ZEND_RETURN_VALUE, 0)
 ZEND_END_ARG_INFO()
 
@@ -600,6 +791,21 @@ ZEND_BEGIN_ARG_INFO_EX(arginfo_ssl, 0, ZEND_RETURN_VALUE, 1)
   ZEND_ARG_OBJ_INFO(0, options, Cassandra\\SSLOptions, 0)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_retry_policy, 0, ZEND_RETURN_VALUE, 1)
+  ZEND_ARG_OBJ_INFO(0, policy, Cassandra\\RetryPolicy, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_rate_limit, 0, ZEND_RETURN_VALUE, 1)
+  ZEND_ARG_INFO(0, requestsPerSecond)
+  ZEND_ARG_INFO(0, bytesPerSecond)
+  ZEND_ARG_INFO(0, failFast)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_execution_profile, 0, ZEND_RETURN_VALUE, 2)
+  ZEND_ARG_INFO(0, name)
+  ZEND_ARG_OBJ_INFO(0, options, Cassandra\\ExecutionOptions, 0)
+ZEND_END_ARG_INFO()
+
 ZEND_BEGIN_ARG_INFO_EX(arginfo_version, 0, ZEND_RETURN_VALUE, 1)
   ZEND_ARG_INFO(0, version)
 ZEND_END_ARG_INFO()
@@ -621,6 +827,11 @@ ZEND_BEGIN_ARG_INFO_EX(arginfo_delay, 0, ZEND_RETURN_VALUE, 1)
   ZEND_ARG_INFO(0, delay)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_speculative, 0, ZEND_RETURN_VALUE, 1)
+  ZEND_ARG_INFO(0, delay)
+  ZEND_ARG_INFO(0, maxExecutions)
+ZEND_END_ARG_INFO()
+
 static zend_function_entry cassandra_cluster_builder_methods[] = {
   PHP_ME(ClusterBuilder, build, arginfo_none, ZEND_ACC_PUBLIC)
   PHP_ME(ClusterBuilder, withDefaultConsistency, arginfo_consistency,
@@ -641,6 +852,11 @@ static zend_function_entry cassandra_cluster_builder_methods[] = {
   PHP_ME(ClusterBuilder, withConnectTimeout, arginfo_timeout, ZEND_ACC_PUBLIC)
   PHP_ME(ClusterBuilder, withRequestTimeout, arginfo_timeout, ZEND_ACC_PUBLIC)
   PHP_ME(ClusterBuilder, withSSL, arginfo_ssl, ZEND_ACC_PUBLIC)
+  PHP_ME(ClusterBuilder, withRetryPolicy, arginfo_retry_policy,
+         ZEND_ACC_PUBLIC)
+  PHP_ME(ClusterBuilder, withRateLimit, arginfo_rate_limit, ZEND_ACC_PUBLIC)
+  PHP_ME(ClusterBuilder, withExecutionProfile, arginfo_execution_profile,
+         ZEND_ACC_PUBLIC)
   PHP_ME(ClusterBuilder, withPersistentSessions, arginfo_enabled,
          ZEND_ACC_PUBLIC)
   PHP_ME(ClusterBuilder, withProtocolVersion, arginfo_version, ZEND_ACC_PUBLIC)
@@ -655,6 +871,10 @@ static zend_function_entry cassandra_cluster_builder_methods[] = {
         ZEND_ACC_PUBLIC)
   PHP_ME(ClusterBuilder, withTCPKeepalive, arginfo_delay,
         ZEND_ACC_PUBLIC)
+  PHP_ME(ClusterBuilder, withSchemaMetadata, arginfo_enabled,
+        ZEND_ACC_PUBLIC)
+  PHP_ME(ClusterBuilder, withSpeculativeExecution, arginfo_speculative,
+        ZEND_ACC_PUBLIC)
   PHP_FE_END
 };
 
@@ -685,6 +905,7 @@ php_cassandra_cluster_builder_properties(zval *object TSRMLS_DC)
   zval* connectTimeout;
   zval* requestTimeout;
   zval* sslOptions;
+  zval* retryPolicy;
   zval* defaultConsistency;
   zval* defaultPageSize;
   zval* defaultTimeout;
@@ -697,6 +918,10 @@ php_cassandra_cluster_builder_properties(zval *object TSRMLS_DC)
   zval* latencyAwareRouting;
   zval* tcpNodelay;
   zval* tcpKeepalive;
+  zval* schemaMetadata;
+  zval* speculativeExecution;
+  zval* rateLimit;
+  zval* executionProfiles;
 
   MAKE_STD_ZVAL(contactPoints);
   ZVAL_STRING(contactPoints, builder->contact_points, 1);
@@ -742,6 +967,13 @@ php_cassandra_cluster_builder_properties(zval *object TSRMLS_DC)
     ZVAL_NULL(sslOptions);
   }
 
+  MAKE_STD_ZVAL(retryPolicy);
+  if (builder->retry_policy) {
+    ZVAL_ZVAL(retryPolicy, builder->retry_policy, 1, 0);
+  } else {
+    ZVAL_NULL(retryPolicy);
+  }
+
   MAKE_STD_ZVAL(defaultConsistency);
   ZVAL_LONG(defaultConsistency, builder->default_consistency);
   MAKE_STD_ZVAL(defaultPageSize);
@@ -784,6 +1016,37 @@ php_cassandra_cluster_builder_properties(zval *object TSRMLS_DC)
     ZVAL_NULL(tcpKeepalive);
   }
 
+  MAKE_STD_ZVAL(schemaMetadata);
+  ZVAL_BOOL(schemaMetadata, builder->enable_schema);
+
+  MAKE_STD_ZVAL(speculativeExecution);
+  if (builder->speculative_max_executions > 0) {
+    array_init(speculativeExecution);
+    add_assoc_double(speculativeExecution, "delay",
+                     (double) builder->speculative_delay / 1000);
+    add_assoc_long(speculativeExecution, "maxExecutions",
+                   builder->speculative_max_executions);
+  } else {
+    ZVAL_NULL(speculativeExecution);
+  }
+
+  MAKE_STD_ZVAL(rateLimit);
+  if (builder->rate_limit_requests > 0 || builder->rate_limit_bytes > 0) {
+    array_init(rateLimit);
+    add_assoc_long(rateLimit, "requestsPerSecond", builder->rate_limit_requests);
+    add_assoc_long(rateLimit, "bytesPerSecond",    builder->rate_limit_bytes);
+    add_assoc_bool(rateLimit, "failFast",          builder->rate_limit_fail_fast);
+  } else {
+    ZVAL_NULL(rateLimit);
+  }
+
+  MAKE_STD_ZVAL(executionProfiles);
+  if (builder->profiles) {
+    ZVAL_ZVAL(executionProfiles, builder->profiles, 1, 0);
+  } else {
+    array_init(executionProfiles);
+  }
+
   zend_hash_update(props, "contactPoints", sizeof("contactPoints"),
                    &contactPoints, sizeof(zval), NULL);
   zend_hash_update(props, "loadBalancingPolicy", sizeof("loadBalancingPolicy"),
@@ -810,6 +1073,8 @@ php_cassandra_cluster_builder_properties(zval *object TSRMLS_DC)
                    &requestTimeout, sizeof(zval), NULL);
   zend_hash_update(props, "sslOptions", sizeof("sslOptions"),
                    &sslOptions, sizeof(zval), NULL);
+  zend_hash_update(props, "retryPolicy", sizeof("retryPolicy"),
+                   &retryPolicy, sizeof(zval), NULL);
   zend_hash_update(props, "defaultConsistency", sizeof("defaultConsistency"),
                    &defaultConsistency, sizeof(zval), NULL);
   zend_hash_update(props, "defaultPageSize", sizeof("defaultPageSize"),
@@ -837,6 +1102,14 @@ php_cassandra_cluster_builder_properties(zval *object TSRMLS_DC)
                    sizeof(zval), NULL);
   zend_hash_update(props, "tcpKeepalive", sizeof("tcpKeepalive"),
                    &tcpKeepalive, sizeof(zval), NULL);
+  zend_hash_update(props, "schemaMetadata", sizeof("schemaMetadata"),
+                   &schemaMetadata, sizeof(zval), NULL);
+  zend_hash_update(props, "speculativeExecution", sizeof("speculativeExecution"),
+                   &speculativeExecution, sizeof(zval), NULL);
+  zend_hash_update(props, "rateLimit", sizeof("rateLimit"),
+                   &rateLimit, sizeof(zval), NULL);
+  zend_hash_update(props, "executionProfiles", sizeof("executionProfiles"),
+                   &executionProfiles, sizeof(zval), NULL);
 
   return props;
 }
@@ -879,6 +1152,16 @@ php_cassandra_cluster_builder_free(void *object TSRMLS_DC)
     builder->ssl_options = NULL;
   }
 
+  if (builder->retry_policy) {
+    zval_ptr_dtor(&builder->retry_policy);
+    builder->retry_policy = NULL;
+  }
+
+  if (builder->profiles) {
+    zval_ptr_dtor(&builder->profiles);
+    builder->profiles = NULL;
+  }
+
   if (builder->default_timeout) {
     zval_ptr_dtor(&builder->default_timeout);
     builder->default_timeout = NULL;
@@ -910,6 +1193,7 @@ php_cassandra_cluster_builder_new(zend_class_entry* class_type TSRMLS_DC)
   builder->connect_timeout = 5000;
   builder->request_timeout = 12000;
   builder->ssl_options = NULL;
+  builder->retry_policy = NULL;
   builder->default_consistency = CASS_CONSISTENCY_ONE;
   builder->default_page_size = 5000;
   builder->default_timeout = NULL;
@@ -923,6 +1207,13 @@ php_cassandra_cluster_builder_new(zend_class_entry* class_type TSRMLS_DC)
   builder->enable_tcp_nodelay = 1;
   builder->enable_tcp_keepalive = 0;
   builder->tcp_keepalive_delay = 0;
+  builder->enable_schema = 1;
+  builder->speculative_delay = 0;
+  builder->speculative_max_executions = 0;
+  builder->rate_limit_requests = 0;
+  builder->rate_limit_bytes = 0;
+  builder->rate_limit_fail_fast = 0;
+  builder->profiles = NULL;
 
   retval.handle   = zend_objects_store_put(builder,
                       (zend_objects_store_dtor_t) zend_objects_destroy_object,
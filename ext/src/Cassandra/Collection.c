@@ -1,5 +1,6 @@
 #include "php_cassandra.h"
 #include "util/collections.h"
+#include "util/iterator.h"
 #include "src/Cassandra/Collection.h"
 
 zend_class_entry *cassandra_collection_ce = NULL;
@@ -360,6 +361,16 @@ php_cassandra_collection_free(void *object TSRMLS_DC)
   efree(collection);
 }
 
+static zend_object_iterator*
+php_cassandra_collection_get_iterator(zend_class_entry* ce, zval* object, int by_ref TSRMLS_DC)
+{
+  cassandra_collection* collection =
+    (cassandra_collection*) zend_object_store_get_object(object TSRMLS_CC);
+
+  return php_cassandra_iterator_new(object, &collection->values,
+                                    php_cassandra_iterator_key_hash, by_ref TSRMLS_CC);
+}
+
 static zend_object_value
 php_cassandra_collection_new(zend_class_entry* class_type TSRMLS_DC)
 {
@@ -395,5 +406,6 @@ void cassandra_define_Collection(TSRMLS_D)
   cassandra_collection_handlers.compare_objects = php_cassandra_collection_compare;
   cassandra_collection_ce->ce_flags |= ZEND_ACC_FINAL_CLASS;
   cassandra_collection_ce->create_object = php_cassandra_collection_new;
+  cassandra_collection_ce->get_iterator  = php_cassandra_collection_get_iterator;
   zend_class_implements(cassandra_collection_ce TSRMLS_CC, 2, spl_ce_Countable, zend_ce_iterator);
 }
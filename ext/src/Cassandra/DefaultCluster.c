@@ -1,5 +1,7 @@
 #include "php_cassandra.h"
+#include "util/fork.h"
 #include "util/future.h"
+#include "util/psession.h"
 
 zend_class_entry *cassandra_default_cluster_ce = NULL;
 
@@ -30,45 +32,61 @@ PHP_METHOD(DefaultCluster, connect)
   session->default_page_size   = cluster->default_page_size;
   session->default_timeout     = cluster->default_timeout;
   session->persist             = cluster->persist;
+  session->rate_limit          = cluster->rate_limit;
 
   if (session->default_timeout) {
     Z_ADDREF_P(session->default_timeout);
   }
 
+  if (cluster->profiles) {
+    session->profiles = cluster->profiles;
+    Z_ADDREF_P(session->profiles);
+  }
+
   if (session->persist) {
     zend_rsrc_list_entry *le;
 
+    php_cassandra_fork_check(TSRMLS_C);
+
     hash_key_len = spprintf(&hash_key, 0, "%s:session:%s",
                             cluster->hash_key, SAFE_STR(keyspace));
 
     if (zend_hash_find(&EG(persistent_list), hash_key, hash_key_len + 1, (void **)&le) == SUCCESS &&
         Z_TYPE_P(le) == php_le_cassandra_session()) {
       psession = (cassandra_psession*) le->ptr;
-      session->session = psession->session;
+      php_cassandra_psession_touch(psession);
+
+      if (php_cassandra_psession_check(psession TSRMLS_CC) == FAILURE) {
+        efree(hash_key);
+        return;
+      }
+
+      session->session  = psession->session;
+      session->psession = psession;
       future = psession->future;
     }
   }
 
   if (future == NULL) {
-    session->session = cass_session_new();
-
-    if (keyspace) {
-      future = cass_session_connect_keyspace(session->session, cluster->cluster, keyspace);
-    } else {
-      future = cass_session_connect(session->session, cluster->cluster);
-    }
-
     if (session->persist) {
       zend_rsrc_list_entry pe;
-      psession = (cassandra_psession*) pecalloc(1, sizeof(cassandra_psession), 1);
-      psession->session = session->session;
-      psession->future  = future;
+
+      psession = php_cassandra_psession_new(cluster->cluster, keyspace);
+      session->session  = psession->session;
+      session->psession = psession;
+      future = psession->future;
 
       pe.type = php_le_cassandra_session();
       pe.ptr  = psession;
 
       zend_hash_update(&EG(persistent_list), hash_key, hash_key_len + 1, &pe, sizeof(zend_rsrc_list_entry), NULL);
       CASSANDRA_G(persistent_sessions)++;
+    } else if (keyspace) {
+      session->session = cass_session_new();
+      future = cass_session_connect_keyspace(session->session, cluster->cluster, keyspace);
+    } else {
+      session->session = cass_session_new();
+      future = cass_session_connect(session->session, cluster->cluster);
     }
   }
 
@@ -84,10 +102,8 @@ PHP_METHOD(DefaultCluster, connect)
 
   if (php_cassandra_future_is_error(future TSRMLS_CC) == FAILURE) {
     if (session->persist) {
-      if (zend_hash_del(&EG(persistent_list), hash_key, hash_key_len + 1) == SUCCESS) {
-        session->session = NULL;
-      }
-
+      /* Rebuilt at the end of the request, failing fast until then */
+      php_cassandra_psession_failed(session->psession, future);
       efree(hash_key);
     } else {
       cass_future_free(future);
@@ -118,11 +134,19 @@ PHP_METHOD(DefaultCluster, connectAsync)
   object_init_ex(return_value, cassandra_future_session_ce);
   future = (cassandra_future_session*) zend_object_store_get_object(return_value TSRMLS_CC);
 
-  future->persist = cluster->persist;
+  future->persist    = cluster->persist;
+  future->rate_limit = cluster->rate_limit;
+
+  if (cluster->profiles) {
+    future->profiles = cluster->profiles;
+    Z_ADDREF_P(future->profiles);
+  }
 
   if (cluster->persist) {
     zend_rsrc_list_entry *le;
 
+    php_cassandra_fork_check(TSRMLS_C);
+
     hash_key_len = spprintf(&hash_key, 0,
       "%s:session:%s", cluster->hash_key, SAFE_STR(keyspace));
 
@@ -132,33 +156,37 @@ PHP_METHOD(DefaultCluster, connectAsync)
     if (zend_hash_find(&EG(persistent_list), hash_key, hash_key_len + 1, (void **)&le) == SUCCESS) {
       if (Z_TYPE_P(le) == php_le_cassandra_session()) {
         cassandra_psession* psession = (cassandra_psession*) le->ptr;
-        future->session = psession->session;
-        future->future  = psession->future;
+        php_cassandra_psession_touch(psession);
+
+        if (php_cassandra_psession_check(psession TSRMLS_CC) == FAILURE)
+          return;
+
+        future->session  = psession->session;
+        future->future   = psession->future;
+        future->psession = psession;
         return;
       }
     }
   }
 
-  future->session = cass_session_new();
-
-  if (keyspace) {
-    future->future = cass_session_connect_keyspace(future->session, cluster->cluster, keyspace);
-  } else {
-    future->future = cass_session_connect(future->session, cluster->cluster);
-  }
-
   if (cluster->persist) {
     zend_rsrc_list_entry le;
-    cassandra_psession* psession =
-      (cassandra_psession*) pecalloc(1, sizeof(cassandra_psession), 1);
-    psession->session = future->session;
-    psession->future  = future->future;
+
+    future->psession = php_cassandra_psession_new(cluster->cluster, keyspace);
+    future->session  = future->psession->session;
+    future->future   = future->psession->future;
 
     le.type = php_le_cassandra_session();
-    le.ptr  = psession;
+    le.ptr  = future->psession;
 
     zend_hash_update(&EG(persistent_list), hash_key, hash_key_len + 1, &le, sizeof(zend_rsrc_list_entry), NULL);
     CASSANDRA_G(persistent_sessions)++;
+  } else if (keyspace) {
+    future->session = cass_session_new();
+    future->future  = cass_session_connect_keyspace(future->session, cluster->cluster, keyspace);
+  } else {
+    future->session = cass_session_new();
+    future->future  = cass_session_connect(future->session, cluster->cluster);
   }
 }
 
@@ -209,6 +237,9 @@ php_cassandra_default_cluster_free(void *object TSRMLS_DC)
     cass_cluster_free(cluster->cluster);
   }
 
+  if (cluster->profiles)
+    zval_ptr_dtor(&cluster->profiles);
+
   efree(cluster);
 }
 
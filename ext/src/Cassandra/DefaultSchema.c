@@ -17,9 +17,9 @@ PHP_METHOD(DefaultSchema, keyspace)
 
   self = (cassandra_schema*) zend_object_store_get_object(getThis() TSRMLS_CC);
 #if CURRENT_CPP_DRIVER_VERSION >= CPP_DRIVER_VERSION(2, 2, 0)
-  meta = cass_schema_meta_keyspace_by_name_n((CassSchemaMeta*) self->schema->data, name, name_len);
+  meta = cass_schema_meta_keyspace_by_name_n(((cassandra_schema_snapshot*) self->schema->data)->meta, name, name_len);
 #else
-  meta = cass_schema_get_keyspace_n((CassSchema*) self->schema->data, name, name_len);
+  meta = cass_schema_get_keyspace_n(((cassandra_schema_snapshot*) self->schema->data)->meta, name, name_len);
 #endif
 
   if (meta == NULL) {
@@ -42,9 +42,9 @@ PHP_METHOD(DefaultSchema, keyspaces)
 
   self     = (cassandra_schema*) zend_object_store_get_object(getThis() TSRMLS_CC);
 #if CURRENT_CPP_DRIVER_VERSION >= CPP_DRIVER_VERSION(2, 2, 0)
-  iterator = cass_iterator_keyspaces_from_schema_meta((CassSchemaMeta*) self->schema->data);
+  iterator = cass_iterator_keyspaces_from_schema_meta(((cassandra_schema_snapshot*) self->schema->data)->meta);
 #else
-  iterator = cass_iterator_from_schema((CassSchema*) self->schema->data);
+  iterator = cass_iterator_from_schema(((cassandra_schema_snapshot*) self->schema->data)->meta);
 #endif
 
   array_init(return_value);
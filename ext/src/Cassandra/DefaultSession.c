@@ -1,278 +1,27 @@
 #include "php_cassandra.h"
+#include "util/bind.h"
 #include "util/bytes.h"
 #include "util/future.h"
 #include "util/result.h"
 #include "util/ref.h"
-#include "util/math.h"
-#include "util/collections.h"
+#include "util/schema.h"
+#include "util/execution_info.h"
+#include "util/metrics.h"
+#include "util/rate_limit.h"
+#include "util/slow_query.h"
+#include "util/stats.h"
+#include "src/Cassandra/BoundStatement.h"
+#include "src/Cassandra/PreparedStatement.h"
 
 zend_class_entry *cassandra_default_session_ce = NULL;
 
-#define CHECK_RESULT(rc) \
-{ \
-  ASSERT_SUCCESS_VALUE(rc, FAILURE) \
-  return SUCCESS; \
-}
-
-static int
-bind_argument_by_index(CassStatement* statement, size_t index, zval* value TSRMLS_DC)
-{
-  if (Z_TYPE_P(value) == IS_NULL)
-    CHECK_RESULT(cass_statement_bind_null(statement, index));
-
-  if (Z_TYPE_P(value) == IS_STRING)
-    CHECK_RESULT(cass_statement_bind_string(statement, index, Z_STRVAL_P(value)));
-
-  if (Z_TYPE_P(value) == IS_DOUBLE)
-    CHECK_RESULT(cass_statement_bind_double(statement, index, Z_DVAL_P(value)));
-
-  if (Z_TYPE_P(value) == IS_LONG)
-    CHECK_RESULT(cass_statement_bind_int32(statement, index, Z_LVAL_P(value)));
-
-  if (Z_TYPE_P(value) == IS_BOOL)
-    CHECK_RESULT(cass_statement_bind_bool(statement, index, Z_BVAL_P(value)));
-
-  if (Z_TYPE_P(value) == IS_OBJECT) {
-    if (instanceof_function(Z_OBJCE_P(value), cassandra_float_ce TSRMLS_CC)) {
-      cassandra_float* float_number = (cassandra_float*) zend_object_store_get_object(value TSRMLS_CC);
-      CHECK_RESULT(cass_statement_bind_float(statement, index, float_number->value));
-    }
-
-    if (instanceof_function(Z_OBJCE_P(value), cassandra_bigint_ce TSRMLS_CC)) {
-      cassandra_bigint* bigint = (cassandra_bigint*) zend_object_store_get_object(value TSRMLS_CC);
-      CHECK_RESULT(cass_statement_bind_int64(statement, index, bigint->value));
-    }
-
-    if (instanceof_function(Z_OBJCE_P(value), cassandra_timestamp_ce TSRMLS_CC)) {
-      cassandra_timestamp* timestamp = (cassandra_timestamp*) zend_object_store_get_object(value TSRMLS_CC);
-      CHECK_RESULT(cass_statement_bind_int64(statement, index, timestamp->timestamp));
-    }
-
-    if (instanceof_function(Z_OBJCE_P(value), cassandra_blob_ce TSRMLS_CC)) {
-      cassandra_blob* blob = (cassandra_blob*) zend_object_store_get_object(value TSRMLS_CC);
-      CHECK_RESULT(cass_statement_bind_bytes(statement, index, blob->data, blob->size));
-    }
-
-    if (instanceof_function(Z_OBJCE_P(value), cassandra_varint_ce TSRMLS_CC)) {
-      cassandra_varint* varint = (cassandra_varint*) zend_object_store_get_object(value TSRMLS_CC);
-      size_t size;
-      cass_byte_t* data = export_twos_complement(varint->value, &size);
-      CassError rc = cass_statement_bind_bytes(statement, index, data, size);
-      free(data);
-      CHECK_RESULT(rc);
-    }
-
-    if (instanceof_function(Z_OBJCE_P(value), cassandra_decimal_ce TSRMLS_CC)) {
-      cassandra_decimal* decimal = (cassandra_decimal*) zend_object_store_get_object(value TSRMLS_CC);
-      size_t size;
-      cass_byte_t* data = (cass_byte_t*) export_twos_complement(decimal->value, &size);
-      CassError rc = cass_statement_bind_decimal(statement, index, data, size, decimal->scale);
-      free(data);
-      CHECK_RESULT(rc);
-    }
-
-    if (instanceof_function(Z_OBJCE_P(value), cassandra_uuid_interface_ce TSRMLS_CC)) {
-      cassandra_uuid* uuid = (cassandra_uuid*) zend_object_store_get_object(value TSRMLS_CC);
-      CHECK_RESULT(cass_statement_bind_uuid(statement, index, uuid->uuid));
-    }
-
-    if (instanceof_function(Z_OBJCE_P(value), cassandra_inet_ce TSRMLS_CC)) {
-      cassandra_inet* inet = (cassandra_inet*) zend_object_store_get_object(value TSRMLS_CC);
-      CHECK_RESULT(cass_statement_bind_inet(statement, index, inet->inet));
-    }
-
-    if (instanceof_function(Z_OBJCE_P(value), cassandra_set_ce TSRMLS_CC)) {
-      CassError rc;
-      CassCollection* collection;
-      cassandra_set* set = (cassandra_set*) zend_object_store_get_object(value TSRMLS_CC);
-      if (!php_cassandra_collection_from_set(set, &collection TSRMLS_CC))
-        return FAILURE;
-
-      rc = cass_statement_bind_collection(statement, index, collection);
-      cass_collection_free(collection);
-      CHECK_RESULT(rc);
-    }
-
-    if (instanceof_function(Z_OBJCE_P(value), cassandra_map_ce TSRMLS_CC)) {
-      CassError rc;
-      CassCollection* collection;
-      cassandra_map* map = (cassandra_map*) zend_object_store_get_object(value TSRMLS_CC);
-      if (!php_cassandra_collection_from_map(map, &collection TSRMLS_CC))
-        return FAILURE;
-
-      rc = cass_statement_bind_collection(statement, index, collection);
-      cass_collection_free(collection);
-      CHECK_RESULT(rc);
-    }
-
-    if (instanceof_function(Z_OBJCE_P(value), cassandra_collection_ce TSRMLS_CC)) {
-      CassError rc;
-      CassCollection* collection;
-      cassandra_collection* coll = (cassandra_collection*) zend_object_store_get_object(value TSRMLS_CC);
-      if (!php_cassandra_collection_from_collection(coll, &collection TSRMLS_CC))
-        return FAILURE;
-
-      rc = cass_statement_bind_collection(statement, index, collection);
-      cass_collection_free(collection);
-      CHECK_RESULT(rc);
-    }
-  }
-
-  return FAILURE;
-}
-
-static int
-bind_argument_by_name(CassStatement* statement, const char* name, zval* value TSRMLS_DC)
-{
-  if (Z_TYPE_P(value) == IS_NULL) {
-    CHECK_RESULT(cass_statement_bind_null_by_name(statement, name));
-  }
-
-  if (Z_TYPE_P(value) == IS_STRING)
-    CHECK_RESULT(cass_statement_bind_string_by_name(statement, name, Z_STRVAL_P(value)));
-
-  if (Z_TYPE_P(value) == IS_DOUBLE)
-    CHECK_RESULT(cass_statement_bind_double_by_name(statement, name, Z_DVAL_P(value)));
-
-  if (Z_TYPE_P(value) == IS_LONG)
-    CHECK_RESULT(cass_statement_bind_int32_by_name(statement, name, Z_LVAL_P(value)));
-
-  if (Z_TYPE_P(value) == IS_BOOL)
-    CHECK_RESULT(cass_statement_bind_bool_by_name(statement, name, Z_BVAL_P(value)));
-
-  if (Z_TYPE_P(value) == IS_OBJECT) {
-    if (instanceof_function(Z_OBJCE_P(value), cassandra_float_ce TSRMLS_CC)) {
-      cassandra_float* float_number = (cassandra_float*) zend_object_store_get_object(value TSRMLS_CC);
-      CHECK_RESULT(cass_statement_bind_float_by_name(statement, name, float_number->value));
-    }
-
-    if (instanceof_function(Z_OBJCE_P(value), cassandra_bigint_ce TSRMLS_CC)) {
-      cassandra_bigint* bigint = (cassandra_bigint*) zend_object_store_get_object(value TSRMLS_CC);
-      CHECK_RESULT(cass_statement_bind_int64_by_name(statement, name, bigint->value));
-    }
-
-    if (instanceof_function(Z_OBJCE_P(value), cassandra_timestamp_ce TSRMLS_CC)) {
-      cassandra_timestamp* timestamp = (cassandra_timestamp*) zend_object_store_get_object(value TSRMLS_CC);
-      CHECK_RESULT(cass_statement_bind_int64_by_name(statement, name, timestamp->timestamp));
-    }
-
-    if (instanceof_function(Z_OBJCE_P(value), cassandra_blob_ce TSRMLS_CC)) {
-      cassandra_blob* blob = (cassandra_blob*) zend_object_store_get_object(value TSRMLS_CC);
-      CHECK_RESULT(cass_statement_bind_bytes_by_name(statement, name, blob->data, blob->size));
-    }
-
-    if (instanceof_function(Z_OBJCE_P(value), cassandra_varint_ce TSRMLS_CC)) {
-      cassandra_varint* varint = (cassandra_varint*) zend_object_store_get_object(value TSRMLS_CC);
-      size_t size;
-      cass_byte_t* data = (cass_byte_t*) export_twos_complement(varint->value, &size);
-      CassError rc = cass_statement_bind_bytes_by_name(statement, name, data, size);
-      free(data);
-      CHECK_RESULT(rc);
-    }
-
-    if (instanceof_function(Z_OBJCE_P(value), cassandra_decimal_ce TSRMLS_CC)) {
-      cassandra_decimal* decimal = (cassandra_decimal*) zend_object_store_get_object(value TSRMLS_CC);
-      size_t size;
-      cass_byte_t* data = (cass_byte_t*) export_twos_complement(decimal->value, &size);
-      CassError rc = cass_statement_bind_decimal_by_name(statement, name, data, size, decimal->scale);
-      free(data);
-      CHECK_RESULT(rc);
-    }
-
-    if (instanceof_function(Z_OBJCE_P(value), cassandra_uuid_interface_ce TSRMLS_CC)) {
-      cassandra_uuid* uuid = (cassandra_uuid*) zend_object_store_get_object(value TSRMLS_CC);
-      CHECK_RESULT(cass_statement_bind_uuid_by_name(statement, name, uuid->uuid));
-    }
-
-    if (instanceof_function(Z_OBJCE_P(value), cassandra_inet_ce TSRMLS_CC)) {
-      cassandra_inet* inet = (cassandra_inet*) zend_object_store_get_object(value TSRMLS_CC);
-      CHECK_RESULT(cass_statement_bind_inet_by_name(statement, name, inet->inet));
-    }
-
-    if (instanceof_function(Z_OBJCE_P(value), cassandra_set_ce TSRMLS_CC)) {
-      CassError rc;
-      CassCollection* collection;
-      cassandra_set* set = (cassandra_set*) zend_object_store_get_object(value TSRMLS_CC);
-      if (!php_cassandra_collection_from_set(set, &collection TSRMLS_CC))
-        return FAILURE;
-
-      rc = cass_statement_bind_collection_by_name(statement, name, collection);
-      cass_collection_free(collection);
-      CHECK_RESULT(rc);
-    }
-
-    if (instanceof_function(Z_OBJCE_P(value), cassandra_map_ce TSRMLS_CC)) {
-      CassError rc;
-      CassCollection* collection;
-      cassandra_map* map = (cassandra_map*) zend_object_store_get_object(value TSRMLS_CC);
-      if (!php_cassandra_collection_from_map(map, &collection TSRMLS_CC))
-        return FAILURE;
-
-      rc = cass_statement_bind_collection_by_name(statement, name, collection);
-      cass_collection_free(collection);
-      CHECK_RESULT(rc);
-    }
-
-    if (instanceof_function(Z_OBJCE_P(value), cassandra_collection_ce TSRMLS_CC)) {
-      CassError rc;
-      CassCollection* collection;
-      cassandra_collection* coll = (cassandra_collection*) zend_object_store_get_object(value TSRMLS_CC);
-      if (!php_cassandra_collection_from_collection(coll, &collection TSRMLS_CC))
-        return FAILURE;
-
-      rc = cass_statement_bind_collection_by_name(statement, name, collection);
-      cass_collection_free(collection);
-      CHECK_RESULT(rc);
-    }
-  }
-
-  return FAILURE;
-}
-
-static int
-bind_arguments(CassStatement* statement, HashTable* arguments TSRMLS_DC)
-{
-  HashPointer ptr;
-  ulong       hashIndex = 0;
-  char*       hashKey   = NULL;
-  zval**      value;
-  int         rc        = SUCCESS;
-
-  zend_hash_get_pointer(arguments, &ptr);
-  zend_hash_internal_pointer_reset(arguments);
-
-  while (zend_hash_get_current_data(arguments, (void**) &value) == SUCCESS) {
-    switch (zend_hash_get_current_key(arguments, &hashKey, &hashIndex, 0)) {
-    case HASH_KEY_IS_STRING:
-      rc = bind_argument_by_name(statement, hashKey, *value TSRMLS_CC);
-      break;
-    case HASH_KEY_IS_LONG:
-      rc = bind_argument_by_index(statement, hashIndex, *value TSRMLS_CC);
-      break;
-    default:
-      zend_throw_exception_ex(cassandra_runtime_exception_ce, 0 TSRMLS_CC,
-        "Unable to find name or index of the argument.");
-      return FAILURE;
-    }
-
-    if (rc == FAILURE)
-      break;
-
-    zend_hash_move_forward(arguments);
-  }
-
-  zend_hash_set_pointer(arguments, &ptr);
-
-  return rc;
-}
-
 static CassStatement*
 create_statement(cassandra_statement* statement, HashTable* arguments TSRMLS_DC)
 {
   CassStatement* stmt;
   zend_uint count;
   cassandra_simple_statement* simple;
-  cassandra_prepared_statement* prepared;
+  cassandra_prepared_statement* prepared = NULL;
 
   switch (statement->type) {
   case CASSANDRA_SIMPLE_STATEMENT:
@@ -288,13 +37,25 @@ create_statement(cassandra_statement* statement, HashTable* arguments TSRMLS_DC)
     prepared = (cassandra_prepared_statement*) statement;
     stmt = cass_prepared_bind(prepared->prepared);
     break;
+  case CASSANDRA_BOUND_STATEMENT:
+    prepared = (cassandra_prepared_statement*) zend_object_store_get_object(
+                 ((cassandra_bound_statement*) statement)->prepared_statement TSRMLS_CC);
+    /* A copy, so that its values can be added to for this execution only */
+    stmt = php_cassandra_bound_statement_build((cassandra_bound_statement*) statement TSRMLS_CC);
+
+    if (!stmt) {
+      PHP_CASSANDRA_COUNTER_ADD(binding_errors, 1);
+      return NULL;
+    }
+    break;
   default:
     zend_throw_exception_ex(cassandra_runtime_exception_ce, 0 TSRMLS_CC,
       "Unsupported statement type.");
     return NULL;
   }
 
-  if (arguments && bind_arguments(stmt, arguments TSRMLS_CC) == FAILURE) {
+  if (arguments && php_cassandra_bind_arguments(stmt, prepared, arguments TSRMLS_CC) == FAILURE) {
+    PHP_CASSANDRA_COUNTER_ADD(binding_errors, 1);
     cass_statement_free(stmt);
     return NULL;
   }
@@ -302,8 +63,28 @@ create_statement(cassandra_statement* statement, HashTable* arguments TSRMLS_DC)
   return stmt;
 }
 
+/* The driver times out the request itself, which frees its stream and
+ * in-flight slot, rather than leaving it running after the PHP side has
+ * stopped waiting. Returns 0 when no timeout is given. */
+static cass_uint64_t
+request_timeout(zval* timeout)
+{
+  if (timeout == NULL)
+    return 0;
+
+  if (Z_TYPE_P(timeout) == IS_LONG && Z_LVAL_P(timeout) > 0)
+    return (cass_uint64_t) Z_LVAL_P(timeout) * 1000;
+
+  if (Z_TYPE_P(timeout) == IS_DOUBLE && Z_DVAL_P(timeout) > 0)
+    return (cass_uint64_t) ceil(Z_DVAL_P(timeout) * 1000);
+
+  return 0;
+}
+
 static CassBatch*
-create_batch(cassandra_batch_statement* batch, CassConsistency consistency TSRMLS_DC)
+create_batch(cassandra_batch_statement* batch, CassConsistency consistency,
+             zval* timeout, int idempotent,
+             CassRetryPolicy* retry_policy TSRMLS_DC)
 {
   HashPosition pos;
   void** data;
@@ -330,6 +111,19 @@ create_batch(cassandra_batch_statement* batch, CassConsistency consistency TSRML
 
   rc = cass_batch_set_consistency(cass_batch, consistency);
 
+#if CURRENT_CPP_DRIVER_VERSION >= CPP_DRIVER_VERSION(2, 5, 0)
+  if (rc == CASS_OK && request_timeout(timeout) > 0)
+    rc = cass_batch_set_request_timeout(cass_batch, request_timeout(timeout));
+#endif
+
+#if CURRENT_CPP_DRIVER_VERSION >= CPP_DRIVER_VERSION(2, 7, 0)
+  if (rc == CASS_OK && idempotent >= 0)
+    rc = cass_batch_set_is_idempotent(cass_batch, idempotent ? cass_true : cass_false);
+#endif
+
+  if (rc == CASS_OK && retry_policy)
+    rc = cass_batch_set_retry_policy(cass_batch, retry_policy);
+
   ASSERT_SUCCESS_BLOCK(rc,
     cass_batch_free(cass_batch);
     return NULL;
@@ -338,24 +132,60 @@ create_batch(cassandra_batch_statement* batch, CassConsistency consistency TSRML
   return cass_batch;
 }
 
+/* Bound statements executed without additional arguments reuse their
+ * driver statement rather than binding a new one. */
+static int
+reuses_statement(cassandra_statement* statement, HashTable* arguments)
+{
+  return statement->type == CASSANDRA_BOUND_STATEMENT && !arguments;
+}
+
 static CassStatement*
 create_single(cassandra_statement* statement, HashTable* arguments,
               CassConsistency consistency, long serial_consistency,
-              int page_size TSRMLS_DC)
+              int page_size, zval* timeout, int idempotent,
+              CassRetryPolicy* retry_policy TSRMLS_DC)
 {
   CassError rc = CASS_OK;
-  CassStatement* stmt = create_statement(statement, arguments TSRMLS_CC);
+  CassStatement* stmt = NULL;
+  /* A reused statement still carries the options of its previous execution,
+   * the ones that are not given are reset to the driver's defaults. */
+  int reset = reuses_statement(statement, arguments);
+
+  if (reset)
+    stmt = php_cassandra_bound_statement_acquire((cassandra_bound_statement*) statement TSRMLS_CC);
+  else
+    stmt = create_statement(statement, arguments TSRMLS_CC);
+
   if (!stmt)
     return NULL;
 
   rc = cass_statement_set_consistency(stmt, consistency);
 
-  if (rc == CASS_OK && serial_consistency >= 0)
-    rc = cass_statement_set_serial_consistency(stmt, serial_consistency);
+  if (rc == CASS_OK && (serial_consistency >= 0 || reset))
+    rc = cass_statement_set_serial_consistency(stmt, serial_consistency >= 0 ?
+                                                     serial_consistency :
+                                                     CASS_CONSISTENCY_ANY);
 
-  if (rc == CASS_OK && page_size >= 0)
+  if (rc == CASS_OK && (page_size >= 0 || reset))
     rc = cass_statement_set_paging_size(stmt, page_size);
 
+#if CURRENT_CPP_DRIVER_VERSION >= CPP_DRIVER_VERSION(2, 5, 0)
+  if (rc == CASS_OK && (request_timeout(timeout) > 0 || reset))
+    rc = cass_statement_set_request_timeout(stmt, request_timeout(timeout) > 0 ?
+                                                  request_timeout(timeout) :
+                                                  CASS_UINT64_MAX);
+#endif
+
+  /* Only idempotent requests are eligible for speculative execution. */
+#if CURRENT_CPP_DRIVER_VERSION >= CPP_DRIVER_VERSION(2, 7, 0)
+  if (rc == CASS_OK && (idempotent >= 0 || reset))
+    rc = cass_statement_set_is_idempotent(stmt, idempotent > 0 ? cass_true : cass_false);
+#endif
+
+  if (rc == CASS_OK && (retry_policy || reset))
+    rc = cass_statement_set_retry_policy(stmt, retry_policy);
+
   if (rc != CASS_OK) {
     cass_statement_free(stmt);
     zend_throw_exception_ex(exception_class(rc), rc TSRMLS_CC,
@@ -366,12 +196,132 @@ create_single(cassandra_statement* statement, HashTable* arguments,
   return stmt;
 }
 
+/* Throws when the session's rate limit is exceeded in fail-fast mode,
+ * otherwise waits until the request can be sent. The estimated size is
+ * stored in size so that following pages can be charged the same. */
+static int
+rate_limited(cassandra_session* session, cassandra_statement* statement,
+             HashTable* arguments, size_t* size TSRMLS_DC)
+{
+  *size = 0;
+
+  if (!session->rate_limit.requests && !session->rate_limit.bytes)
+    return 0;
+
+  if (session->rate_limit.bytes)
+    *size = php_cassandra_rate_limit_size(statement, arguments TSRMLS_CC);
+
+  return php_cassandra_rate_limit_acquire(&session->rate_limit, *size TSRMLS_CC) == FAILURE;
+}
+
+static void
+watch_statement(CassFuture* future, cassandra_statement* statement TSRMLS_DC)
+{
+  const char* cql = NULL;
+
+  PHP_CASSANDRA_COUNTER_ADD(requests, 1);
+
+  if (!php_cassandra_stats_enabled())
+    return;
+
+  switch (statement->type) {
+    case CASSANDRA_SIMPLE_STATEMENT:
+      cql = ((cassandra_simple_statement*) statement)->cql;
+      break;
+    case CASSANDRA_PREPARED_STATEMENT:
+      cql = ((cassandra_prepared_statement*) statement)->cql;
+      break;
+    case CASSANDRA_BOUND_STATEMENT:
+      cql = ((cassandra_prepared_statement*) zend_object_store_get_object(
+               ((cassandra_bound_statement*) statement)->prepared_statement TSRMLS_CC))->cql;
+      break;
+    case CASSANDRA_BATCH_STATEMENT:
+      cql = PHP_CASSANDRA_STATS_BATCH;
+      break;
+  }
+
+  if (cql)
+    php_cassandra_stats_watch(future, cql, strlen(cql));
+}
+
 static void
 free_statement(void* statement)
 {
   cass_statement_free((CassStatement*) statement);
 }
 
+/* Options are either an instance of Cassandra\ExecutionOptions, which may
+ * name a profile to start from, or just the name of a profile registered on
+ * the cluster. */
+static int
+get_execution_options(cassandra_session* session, zval* options,
+                      cassandra_execution_options** profile,
+                      cassandra_execution_options** opts TSRMLS_DC)
+{
+  const char* name = NULL;
+  int name_len = 0;
+  zval** found;
+
+  *profile = NULL;
+  *opts    = NULL;
+
+  if (!options || Z_TYPE_P(options) == IS_NULL)
+    return SUCCESS;
+
+  if (Z_TYPE_P(options) == IS_STRING) {
+    name     = Z_STRVAL_P(options);
+    name_len = Z_STRLEN_P(options);
+  } else if (Z_TYPE_P(options) == IS_OBJECT &&
+             instanceof_function(Z_OBJCE_P(options), cassandra_execution_options_ce TSRMLS_CC)) {
+    *opts    = (cassandra_execution_options*) zend_object_store_get_object(options TSRMLS_CC);
+    name     = (*opts)->profile;
+    name_len = (*opts)->profile_len;
+  } else {
+    INVALID_ARGUMENT_VALUE(options,
+      "an instance of Cassandra\\ExecutionOptions, the name of an execution profile or null",
+      FAILURE);
+  }
+
+  if (!name)
+    return SUCCESS;
+
+  if (!session->profiles ||
+      zend_hash_find(Z_ARRVAL_P(session->profiles), name, name_len + 1, (void**) &found) == FAILURE) {
+    zend_throw_exception_ex(cassandra_invalid_argument_exception_ce, 0 TSRMLS_CC,
+                            "Unknown execution profile \"%s\"", name);
+    return FAILURE;
+  }
+
+  *profile = (cassandra_execution_options*) zend_object_store_get_object(*found TSRMLS_CC);
+
+  return SUCCESS;
+}
+
+static void
+merge_options(cassandra_execution_options* opts, CassConsistency* consistency,
+              long* serial_consistency, int* page_size, zval** timeout,
+              int* idempotent, CassRetryPolicy** retry_policy TSRMLS_DC)
+{
+  if (opts->consistency >= 0)
+    *consistency = (CassConsistency) opts->consistency;
+
+  if (opts->serial_consistency >= 0)
+    *serial_consistency = opts->serial_consistency;
+
+  if (opts->page_size >= 0)
+    *page_size = opts->page_size;
+
+  if (opts->timeout)
+    *timeout = opts->timeout;
+
+  if (opts->idempotent >= 0)
+    *idempotent = opts->idempotent;
+
+  if (opts->retry_policy)
+    *retry_policy = ((cassandra_retry_policy*)
+      zend_object_store_get_object(opts->retry_policy TSRMLS_CC))->policy;
+}
+
 PHP_METHOD(DefaultSession, execute)
 {
   zval *statement = NULL;
@@ -383,10 +333,15 @@ PHP_METHOD(DefaultSession, execute)
   int page_size = -1;
   zval* timeout = NULL;
   long serial_consistency = -1;
+  int idempotent = -1;
+  CassRetryPolicy* retry_policy = NULL;
+  cassandra_execution_options* profile = NULL;
   cassandra_execution_options* opts = NULL;
   CassFuture* future = NULL;
   CassStatement* single = NULL;
   CassBatch* batch  = NULL;
+  size_t request_size = 0;
+  cassandra_execution_info* info = NULL;
 
   if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z|z", &statement, &options) == FAILURE) {
     return;
@@ -400,52 +355,78 @@ PHP_METHOD(DefaultSession, execute)
   page_size = self->default_page_size;
   timeout = self->default_timeout;
 
-  if (options) {
-    if (!instanceof_function(Z_OBJCE_P(options), cassandra_execution_options_ce TSRMLS_CC)) {
-      INVALID_ARGUMENT(options, "an instance of Cassandra\\ExecutionOptions or null");
-    }
+  if (get_execution_options(self, options, &profile, &opts TSRMLS_CC) == FAILURE)
+    return;
+
+  /* Options given with the request override the ones of its profile */
+  if (profile)
+    merge_options(profile, &consistency, &serial_consistency, &page_size,
+                  &timeout, &idempotent, &retry_policy TSRMLS_CC);
 
-    opts = (cassandra_execution_options*) zend_object_store_get_object(options TSRMLS_CC);
+  if (opts) {
+    merge_options(opts, &consistency, &serial_consistency, &page_size,
+                  &timeout, &idempotent, &retry_policy TSRMLS_CC);
 
     if (opts->arguments)
       arguments = Z_ARRVAL_P(opts->arguments);
-
-    if (opts->consistency >= 0)
-      consistency = (CassConsistency) opts->consistency;
-
-    if (opts->page_size >= 0)
-      page_size = opts->page_size;
-
-    if (opts->timeout)
-      timeout = opts->timeout;
-
-    if (opts->serial_consistency >= 0)
-      serial_consistency = opts->serial_consistency;
   }
 
+  info = php_cassandra_execution_info_new(TSRMLS_C);
+  php_cassandra_execution_info_context(info, statement, opts ? opts->arguments : NULL,
+                                       consistency, page_size TSRMLS_CC);
+  PHP_CASSANDRA_EXECUTION_INFO_MARK(info, bind_start);
+
   switch (stmt->type) {
     case CASSANDRA_SIMPLE_STATEMENT:
     case CASSANDRA_PREPARED_STATEMENT:
+    case CASSANDRA_BOUND_STATEMENT:
       single = create_single(stmt, arguments, consistency,
-                             serial_consistency, page_size TSRMLS_CC);
+                             serial_consistency, page_size, timeout,
+                             idempotent, retry_policy TSRMLS_CC);
 
-      if (!single)
+      if (!single) {
+        php_cassandra_execution_info_free(&info);
+        return;
+      }
+
+      PHP_CASSANDRA_EXECUTION_INFO_MARK(info, bind_end);
+
+      if (rate_limited(self, stmt, arguments, &request_size TSRMLS_CC)) {
+        cass_statement_free(single);
+        php_cassandra_execution_info_free(&info);
         return;
+      }
 
+      PHP_CASSANDRA_EXECUTION_INFO_MARK(info, submit);
       future = cass_session_execute(self->session, single);
+      watch_statement(future, stmt TSRMLS_CC);
       break;
     case CASSANDRA_BATCH_STATEMENT:
-      batch = create_batch((cassandra_batch_statement*) stmt, consistency TSRMLS_CC);
+      batch = create_batch((cassandra_batch_statement*) stmt, consistency, timeout,
+                           idempotent, retry_policy TSRMLS_CC);
 
-      if (!batch)
+      if (!batch) {
+        php_cassandra_execution_info_free(&info);
         return;
+      }
+
+      PHP_CASSANDRA_EXECUTION_INFO_MARK(info, bind_end);
 
+      if (rate_limited(self, stmt, NULL, &request_size TSRMLS_CC)) {
+        cass_batch_free(batch);
+        php_cassandra_execution_info_free(&info);
+        return;
+      }
+
+      PHP_CASSANDRA_EXECUTION_INFO_MARK(info, submit);
       future = cass_session_execute_batch(self->session, batch);
+      watch_statement(future, stmt TSRMLS_CC);
       break;
     default:
+      php_cassandra_execution_info_free(&info);
       INVALID_ARGUMENT(statement,
-        "an instance of Cassandra\\SimpleStatement, " \
-        "Cassandra\\PreparedStatement or Cassandra\\BatchStatement"
+        "an instance of Cassandra\\SimpleStatement, Cassandra\\PreparedStatement, " \
+        "Cassandra\\BoundStatement or Cassandra\\BatchStatement"
       );
       return;
   }
@@ -453,10 +434,22 @@ PHP_METHOD(DefaultSession, execute)
   do {
     const CassResult* result = NULL;
     cassandra_rows* rows = NULL;
+    size_t result_size = 0;
+
+    if (php_cassandra_future_wait_timed(future, timeout TSRMLS_CC) == FAILURE) {
+      php_cassandra_execution_info_attach(info TSRMLS_CC);
+      php_cassandra_slow_query_timeout(info TSRMLS_CC);
+      break;
+    }
 
-    if (php_cassandra_future_wait_timed(future, timeout TSRMLS_CC) == FAILURE ||
-        php_cassandra_future_is_error(future TSRMLS_CC) == FAILURE)
+    PHP_CASSANDRA_EXECUTION_INFO_MARK(info, response);
+
+    if (php_cassandra_future_is_error(future TSRMLS_CC) == FAILURE) {
+      PHP_CASSANDRA_COUNTER_ADD(request_errors, 1);
+      php_cassandra_execution_info_attach(info TSRMLS_CC);
+      php_cassandra_slow_query_check(info TSRMLS_CC);
       break;
+    }
 
     result = cass_future_get_result(future);
     cass_future_free(future);
@@ -470,23 +463,40 @@ PHP_METHOD(DefaultSession, execute)
     object_init_ex(return_value, cassandra_rows_ce);
     rows = (cassandra_rows*) zend_object_store_get_object(return_value TSRMLS_CC);
 
-    if (php_cassandra_get_result(result, &rows->rows TSRMLS_CC) == FAILURE) {
+    if (php_cassandra_get_result(result, &rows->rows,
+                                 info ? &result_size : NULL TSRMLS_CC) == FAILURE) {
       cass_result_free(result);
       break;
     }
 
+    if (info) {
+      PHP_CASSANDRA_EXECUTION_INFO_MARK(info, decode_end);
+      php_cassandra_execution_info_result(info, result, result_size);
+      php_cassandra_slow_query_check(info TSRMLS_CC);
+      rows->info = info;
+      info = NULL;
+    }
+
     if (single && cass_result_has_more_pages(result)) {
       Z_ADDREF_P(getThis());
 
-      rows->statement = php_cassandra_new_ref(single, free_statement);
-      rows->session   = getThis();
-      rows->result    = result;
+      rows->statement    = php_cassandra_new_ref(single, free_statement);
+      rows->session      = getThis();
+      rows->result       = result;
+      rows->request_size = request_size;
       return;
     }
 
     cass_result_free(result);
+
+    if (single && reuses_statement(stmt, arguments)) {
+      php_cassandra_bound_statement_release((cassandra_bound_statement*) stmt, single);
+      single = NULL;
+    }
   } while (0);
 
+  php_cassandra_execution_info_free(&info);
+
   if (batch)
     cass_batch_free(batch);
 
@@ -503,11 +513,16 @@ PHP_METHOD(DefaultSession, executeAsync)
   HashTable* arguments = NULL;
   CassConsistency consistency = CASS_CONSISTENCY_ONE;
   int page_size = -1;
+  zval* timeout = NULL;
   long serial_consistency = -1;
+  int idempotent = -1;
+  CassRetryPolicy* retry_policy = NULL;
+  cassandra_execution_options* profile = NULL;
   cassandra_execution_options* opts = NULL;
   cassandra_future_rows* future_rows = NULL;
   CassStatement* single = NULL;
   CassBatch* batch  = NULL;
+  size_t request_size = 0;
 
   if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "O|z", &statement,
                            cassandra_statement_ce, &options) == FAILURE) {
@@ -520,57 +535,80 @@ PHP_METHOD(DefaultSession, executeAsync)
 
   consistency = self->default_consistency;
   page_size = self->default_page_size;
+  timeout = self->default_timeout;
 
-  if (options) {
-    if (!instanceof_function(Z_OBJCE_P(options), cassandra_execution_options_ce TSRMLS_CC)) {
-      INVALID_ARGUMENT(options, "an instance of Cassandra\\ExecutionOptions or null");
-    }
+  if (get_execution_options(self, options, &profile, &opts TSRMLS_CC) == FAILURE)
+    return;
+
+  /* Options given with the request override the ones of its profile */
+  if (profile)
+    merge_options(profile, &consistency, &serial_consistency, &page_size,
+                  &timeout, &idempotent, &retry_policy TSRMLS_CC);
 
-    opts = (cassandra_execution_options*) zend_object_store_get_object(options TSRMLS_CC);
+  if (opts) {
+    merge_options(opts, &consistency, &serial_consistency, &page_size,
+                  &timeout, &idempotent, &retry_policy TSRMLS_CC);
 
     if (opts->arguments)
       arguments = Z_ARRVAL_P(opts->arguments);
-
-    if (opts->consistency >= 0)
-      consistency = (CassConsistency) opts->consistency;
-
-    if (opts->page_size >= 0)
-      page_size = opts->page_size;
-
-    if (opts->serial_consistency >= 0)
-      serial_consistency = opts->serial_consistency;
   }
 
   object_init_ex(return_value, cassandra_future_rows_ce);
   future_rows = (cassandra_future_rows*) zend_object_store_get_object(return_value TSRMLS_CC);
 
+  future_rows->info = php_cassandra_execution_info_new(TSRMLS_C);
+  php_cassandra_execution_info_context(future_rows->info, statement,
+                                       opts ? opts->arguments : NULL,
+                                       consistency, page_size TSRMLS_CC);
+  PHP_CASSANDRA_EXECUTION_INFO_MARK(future_rows->info, bind_start);
+
   switch (stmt->type) {
     case CASSANDRA_SIMPLE_STATEMENT:
     case CASSANDRA_PREPARED_STATEMENT:
+    case CASSANDRA_BOUND_STATEMENT:
       single = create_single(stmt, arguments, consistency,
-                             serial_consistency, page_size TSRMLS_CC);
+                             serial_consistency, page_size, timeout,
+                             idempotent, retry_policy TSRMLS_CC);
 
       if (!single)
         return;
 
+      if (rate_limited(self, stmt, arguments, &request_size TSRMLS_CC)) {
+        cass_statement_free(single);
+        return;
+      }
+
       Z_ADDREF_P(getThis());
 
-      future_rows->statement = php_cassandra_new_ref(single, free_statement);
-      future_rows->session   = getThis();
-      future_rows->future    = cass_session_execute(self->session, single);
+      PHP_CASSANDRA_EXECUTION_INFO_MARK(future_rows->info, bind_end);
+      PHP_CASSANDRA_EXECUTION_INFO_MARK(future_rows->info, submit);
+      future_rows->statement    = php_cassandra_new_ref(single, free_statement);
+      future_rows->session      = getThis();
+      future_rows->request_size = request_size;
+      future_rows->future       = cass_session_execute(self->session, single);
+      watch_statement(future_rows->future, stmt TSRMLS_CC);
       break;
     case CASSANDRA_BATCH_STATEMENT:
-      batch = create_batch((cassandra_batch_statement*) stmt, consistency TSRMLS_CC);
+      batch = create_batch((cassandra_batch_statement*) stmt, consistency, timeout,
+                           idempotent, retry_policy TSRMLS_CC);
 
       if (!batch)
         return;
 
+      if (rate_limited(self, stmt, NULL, &request_size TSRMLS_CC)) {
+        cass_batch_free(batch);
+        return;
+      }
+
+      PHP_CASSANDRA_EXECUTION_INFO_MARK(future_rows->info, bind_end);
+      PHP_CASSANDRA_EXECUTION_INFO_MARK(future_rows->info, submit);
       future_rows->future = cass_session_execute_batch(self->session, batch);
+      watch_statement(future_rows->future, stmt TSRMLS_CC);
       break;
     default:
       INVALID_ARGUMENT(statement,
-        "an instance of Cassandra\\SimpleStatement, " \
-        "Cassandra\\PreparedStatement or Cassandra\\BatchStatement"
+        "an instance of Cassandra\\SimpleStatement, Cassandra\\PreparedStatement, " \
+        "Cassandra\\BoundStatement or Cassandra\\BatchStatement"
       );
       return;
   }
@@ -610,6 +648,9 @@ PHP_METHOD(DefaultSession, prepare)
       (cassandra_prepared_statement*) zend_object_store_get_object(return_value TSRMLS_CC);
 
     prepared_statement->prepared = cass_future_get_prepared(future);
+    prepared_statement->cql      = estrndup(Z_STRVAL_P(cql), Z_STRLEN_P(cql));
+    php_cassandra_prepared_statement_index(prepared_statement);
+    PHP_CASSANDRA_COUNTER_ADD(prepared_statements, 1);
   }
 
   cass_future_free(future);
@@ -635,6 +676,7 @@ PHP_METHOD(DefaultSession, prepareAsync)
   future_prepared = (cassandra_future_prepared_statement*) zend_object_store_get_object(return_value TSRMLS_CC);
 
   future_prepared->future = future;
+  future_prepared->cql    = estrndup(Z_STRVAL_P(cql), Z_STRLEN_P(cql));
 }
 
 PHP_METHOD(DefaultSession, close)
@@ -682,14 +724,35 @@ PHP_METHOD(DefaultSession, closeAsync)
   future->future = cass_session_close(self->session);
 }
 
-static void
-free_schema(void* schema)
+static cassandra_ref*
+php_cassandra_session_schema(cassandra_session* self)
 {
 #if CURRENT_CPP_DRIVER_VERSION >= CPP_DRIVER_VERSION(2, 2, 0)
-  cass_schema_meta_free((CassSchemaMeta*) schema);
+  const CassSchemaMeta* meta = cass_session_get_schema_meta(self->session);
+
+  /* Keep handing out the cached snapshot until the schema changes. */
+  if (self->schema) {
+    cassandra_schema_snapshot* snapshot = (cassandra_schema_snapshot*) self->schema->data;
+
+    if (cass_schema_meta_snapshot_version(snapshot->meta) ==
+        cass_schema_meta_snapshot_version(meta)) {
+      cass_schema_meta_free(meta);
+      return self->schema;
+    }
+
+    php_cassandra_del_ref(&self->schema);
+  }
+
+  self->schema = php_cassandra_schema_new(meta);
 #else
-  cass_schema_free((CassSchema*) schema);
+  /* Older drivers don't version snapshots, so always take a new one. */
+  if (self->schema)
+    php_cassandra_del_ref(&self->schema);
+
+  self->schema = php_cassandra_schema_new(cass_session_get_schema(self->session));
 #endif
+
+  return self->schema;
 }
 
 PHP_METHOD(DefaultSession, schema)
@@ -703,19 +766,39 @@ PHP_METHOD(DefaultSession, schema)
 
   object_init_ex(return_value, cassandra_default_schema_ce);
   schema = (cassandra_schema*) zend_object_store_get_object(return_value TSRMLS_CC);
+  schema->schema = php_cassandra_add_ref(php_cassandra_session_schema(self));
+}
+
+PHP_METHOD(DefaultSession, schemaVersion)
+{
+  cassandra_session* self =
+    (cassandra_session*) zend_object_store_get_object(getThis() TSRMLS_CC);
+
+  if (zend_parse_parameters_none() == FAILURE)
+    return;
 
 #if CURRENT_CPP_DRIVER_VERSION >= CPP_DRIVER_VERSION(2, 2, 0)
-  schema->schema = php_cassandra_new_ref((void*) cass_session_get_schema_meta(self->session),
-                                         free_schema);
+  RETURN_LONG(cass_schema_meta_snapshot_version(
+    ((cassandra_schema_snapshot*) php_cassandra_session_schema(self)->data)->meta));
 #else
-  schema->schema = php_cassandra_new_ref((void*) cass_session_get_schema(self->session),
-                                         free_schema);
+  RETURN_NULL();
 #endif
 }
 
+PHP_METHOD(DefaultSession, metrics)
+{
+  cassandra_session* self =
+    (cassandra_session*) zend_object_store_get_object(getThis() TSRMLS_CC);
+
+  if (zend_parse_parameters_none() == FAILURE)
+    return;
+
+  php_cassandra_get_metrics(self->session, return_value TSRMLS_CC);
+}
+
 ZEND_BEGIN_ARG_INFO_EX(arginfo_execute, 0, ZEND_RETURN_VALUE, 1)
   ZEND_ARG_OBJ_INFO(0, statement, Cassandra\\Statement, 0)
-  ZEND_ARG_OBJ_INFO(0, options, Cassandra\\ExecutionOptions, 0)
+  ZEND_ARG_INFO(0, options)
 ZEND_END_ARG_INFO()
 
 ZEND_BEGIN_ARG_INFO_EX(arginfo_prepare, 0, ZEND_RETURN_VALUE, 1)
@@ -738,6 +821,8 @@ static zend_function_entry cassandra_default_session_methods[] = {
   PHP_ME(DefaultSession, close, arginfo_timeout, ZEND_ACC_PUBLIC)
   PHP_ME(DefaultSession, closeAsync, arginfo_none, ZEND_ACC_PUBLIC)
   PHP_ME(DefaultSession, schema, arginfo_none, ZEND_ACC_PUBLIC)
+  PHP_ME(DefaultSession, schemaVersion, arginfo_none, ZEND_ACC_PUBLIC)
+  PHP_ME(DefaultSession, metrics, arginfo_none, ZEND_ACC_PUBLIC)
   PHP_FE_END
 };
 
@@ -767,10 +852,20 @@ php_cassandra_default_session_free(void *object TSRMLS_DC)
 
   zend_object_std_dtor(&session->zval TSRMLS_CC);
 
+  if (session->schema) {
+    php_cassandra_del_ref(&session->schema);
+    session->schema = NULL;
+  }
+
   if (!session->persist && session->session) {
     cass_session_free(session->session);
   }
 
+  if (session->profiles) {
+    zval_ptr_dtor(&session->profiles);
+    session->profiles = NULL;
+  }
+
   efree(session);
 }
 
@@ -790,6 +885,8 @@ php_cassandra_default_session_new(zend_class_entry* class_type TSRMLS_DC)
   session->default_consistency = CASS_CONSISTENCY_ONE;
   session->default_page_size   = 5000;
   session->default_timeout     = NULL;
+  session->schema              = NULL;
+  session->psession            = NULL;
 
   retval.handle   = zend_objects_store_put(session,
                       (zend_objects_store_dtor_t) zend_objects_destroy_object,
@@ -1,7 +1,7 @@
 #include "php_cassandra.h"
 #include "util/result.h"
 #include "util/ref.h"
-#include "util/types.h"
+#include "util/schema.h"
 
 zend_class_entry *cassandra_default_table_ce = NULL;
 
@@ -238,9 +238,9 @@ php_cassandra_create_column(cassandra_ref*         schema,
     return NULL;
   );
 
-  if (php_cassandra_parse_column_type(validator, validator_length,
-                                      &column->reversed, &column->frozen,
-                                      &column->type TSRMLS_CC) == FAILURE) {
+  if (php_cassandra_schema_column_type(schema, validator, validator_length,
+                                       &column->reversed, &column->frozen,
+                                       &column->type TSRMLS_CC) == FAILURE) {
     zval_ptr_dtor(&zcolumn);
     return NULL;
   }
@@ -15,6 +15,9 @@ PHP_METHOD(ExecutionOptions, __construct)
   zval** page_size = NULL;
   zval** timeout = NULL;
   zval** arguments = NULL;
+  zval** idempotent = NULL;
+  zval** retry_policy = NULL;
+  zval** profile = NULL;
 
   if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z", &options) == FAILURE) {
     return;
@@ -66,6 +69,30 @@ PHP_METHOD(ExecutionOptions, __construct)
     self->arguments = *arguments;
     Z_ADDREF_P(self->arguments);
   }
+
+  if (zend_hash_find(Z_ARRVAL_P(options), "idempotent", sizeof("idempotent"), (void**)&idempotent) == SUCCESS) {
+    if (Z_TYPE_P(*idempotent) != IS_BOOL) {
+      INVALID_ARGUMENT(*idempotent, "a boolean");
+    }
+    self->idempotent = Z_BVAL_P(*idempotent);
+  }
+
+  if (zend_hash_find(Z_ARRVAL_P(options), "retry_policy", sizeof("retry_policy"), (void**)&retry_policy) == SUCCESS) {
+    if (Z_TYPE_P(*retry_policy) != IS_OBJECT ||
+        !instanceof_function(Z_OBJCE_P(*retry_policy), cassandra_retry_policy_ce TSRMLS_CC)) {
+      INVALID_ARGUMENT(*retry_policy, "an instance of Cassandra\\RetryPolicy");
+    }
+    self->retry_policy = *retry_policy;
+    Z_ADDREF_P(self->retry_policy);
+  }
+
+  if (zend_hash_find(Z_ARRVAL_P(options), "profile", sizeof("profile"), (void**)&profile) == SUCCESS) {
+    if (Z_TYPE_P(*profile) != IS_STRING) {
+      INVALID_ARGUMENT(*profile, "a string");
+    }
+    self->profile     = estrndup(Z_STRVAL_P(*profile), Z_STRLEN_P(*profile));
+    self->profile_len = Z_STRLEN_P(*profile);
+  }
 }
 
 PHP_METHOD(ExecutionOptions, __get)
@@ -106,6 +133,21 @@ PHP_METHOD(ExecutionOptions, __get)
       RETURN_NULL();
     }
     RETURN_ZVAL(self->arguments, 1, 0);
+  } else if (name_len == 10 && strncmp("idempotent", name, name_len) == 0) {
+    if (self->idempotent == -1) {
+      RETURN_NULL();
+    }
+    RETURN_BOOL(self->idempotent);
+  } else if (name_len == 11 && strncmp("retryPolicy", name, name_len) == 0) {
+    if (self->retry_policy == NULL) {
+      RETURN_NULL();
+    }
+    RETURN_ZVAL(self->retry_policy, 1, 0);
+  } else if (name_len == 7 && strncmp("profile", name, name_len) == 0) {
+    if (self->profile == NULL) {
+      RETURN_NULL();
+    }
+    RETURN_STRINGL(self->profile, self->profile_len, 1);
   }
 }
 
@@ -152,6 +194,16 @@ php_cassandra_execution_options_free(void *object TSRMLS_DC)
     options->arguments = NULL;
   }
 
+  if (options->retry_policy) {
+    zval_ptr_dtor(&options->retry_policy);
+    options->retry_policy = NULL;
+  }
+
+  if (options->profile) {
+    efree(options->profile);
+    options->profile = NULL;
+  }
+
   zend_object_std_dtor(&options->zval TSRMLS_CC);
   efree(options);
 }
@@ -172,6 +224,10 @@ php_cassandra_execution_options_new(zend_class_entry* class_type TSRMLS_DC)
   options->page_size = -1;
   options->timeout = NULL;
   options->arguments = NULL;
+  options->idempotent = -1;
+  options->retry_policy = NULL;
+  options->profile = NULL;
+  options->profile_len = 0;
 
   retval.handle   = zend_objects_store_put(options,
                       (zend_objects_store_dtor_t) zend_objects_destroy_object,
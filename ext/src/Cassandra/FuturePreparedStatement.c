@@ -1,6 +1,8 @@
 #include "php_cassandra.h"
 
 #include "util/future.h"
+#include "util/metrics.h"
+#include "src/Cassandra/PreparedStatement.h"
 
 zend_class_entry *cassandra_future_prepared_statement_ce = NULL;
 
@@ -37,6 +39,11 @@ PHP_METHOD(FuturePreparedStatement, get)
   prepared_statement = (cassandra_prepared_statement*) zend_object_store_get_object(return_value TSRMLS_CC);
 
   prepared_statement->prepared = cass_future_get_prepared(self->future);
+  prepared_statement->cql      = self->cql;
+  self->cql = NULL;
+  php_cassandra_prepared_statement_index(prepared_statement);
+
+  PHP_CASSANDRA_COUNTER_ADD(prepared_statements, 1);
 }
 
 ZEND_BEGIN_ARG_INFO_EX(arginfo_timeout, 0, ZEND_RETURN_VALUE, 0)
@@ -84,6 +91,11 @@ php_cassandra_future_prepared_statement_free(void *object TSRMLS_DC)
     future->prepared_statement = NULL;
   }
 
+  if (future->cql) {
+    efree(future->cql);
+    future->cql = NULL;
+  }
+
   efree(future);
 }
 
@@ -99,6 +111,7 @@ php_cassandra_future_prepared_statement_new(zend_class_entry* class_type TSRMLS_
 
   future->future             = NULL;
   future->prepared_statement = NULL;
+  future->cql                = NULL;
 
   retval.handle   = zend_objects_store_put(future,
                       (zend_objects_store_dtor_t) zend_objects_destroy_object,
@@ -1,7 +1,10 @@
 #include "php_cassandra.h"
+#include "util/execution_info.h"
 #include "util/future.h"
+#include "util/metrics.h"
 #include "util/result.h"
 #include "util/ref.h"
+#include "util/slow_query.h"
 
 zend_class_entry *cassandra_future_rows_ce = NULL;
 
@@ -24,6 +27,8 @@ php_cassandra_future_clear(cassandra_future_rows* self)
     cass_future_free(self->future);
     self->future = NULL;
   }
+
+  php_cassandra_execution_info_free(&self->info);
 }
 
 PHP_METHOD(FutureRows, get)
@@ -31,6 +36,7 @@ PHP_METHOD(FutureRows, get)
   zval* timeout = NULL;
   cassandra_rows* rows = NULL;
   const CassResult* result = NULL;
+  size_t result_size = 0;
 
   cassandra_future_rows* self =
     (cassandra_future_rows*) zend_object_store_get_object(getThis() TSRMLS_CC);
@@ -44,10 +50,17 @@ PHP_METHOD(FutureRows, get)
   }
 
   if (php_cassandra_future_wait_timed(self->future, timeout TSRMLS_CC) == FAILURE) {
+    php_cassandra_execution_info_attach(self->info TSRMLS_CC);
+    php_cassandra_slow_query_timeout(self->info TSRMLS_CC);
     return;
   }
 
+  PHP_CASSANDRA_EXECUTION_INFO_MARK(self->info, response);
+
   if (php_cassandra_future_is_error(self->future TSRMLS_CC) == FAILURE) {
+    PHP_CASSANDRA_COUNTER_ADD(request_errors, 1);
+    php_cassandra_execution_info_attach(self->info TSRMLS_CC);
+    php_cassandra_slow_query_check(self->info TSRMLS_CC);
     return;
   }
 
@@ -63,18 +76,28 @@ PHP_METHOD(FutureRows, get)
   object_init_ex(self->rows, cassandra_rows_ce);
   rows = (cassandra_rows*) zend_object_store_get_object(self->rows TSRMLS_CC);
 
-  if (php_cassandra_get_result(result, &rows->rows TSRMLS_CC) == FAILURE) {
+  if (php_cassandra_get_result(result, &rows->rows,
+                               self->info ? &result_size : NULL TSRMLS_CC) == FAILURE) {
     cass_result_free(result);
     zval_ptr_dtor(&self->rows);
     self->rows = NULL;
     return;
   }
 
+  if (self->info) {
+    PHP_CASSANDRA_EXECUTION_INFO_MARK(self->info, decode_end);
+    php_cassandra_execution_info_result(self->info, result, result_size);
+    php_cassandra_slow_query_check(self->info TSRMLS_CC);
+    rows->info = self->info;
+    self->info = NULL;
+  }
+
   if (cass_result_has_more_pages(result)) {
     Z_ADDREF_P(self->session);
-    rows->statement = php_cassandra_add_ref(self->statement);
-    rows->session   = self->session;
-    rows->result    = result;
+    rows->statement    = php_cassandra_add_ref(self->statement);
+    rows->session      = self->session;
+    rows->result       = result;
+    rows->request_size = self->request_size;
   } else {
     cass_result_free(result);
   }
@@ -84,12 +107,37 @@ PHP_METHOD(FutureRows, get)
   RETURN_ZVAL(self->rows, 1, 0);
 }
 
+PHP_METHOD(FutureRows, executionInfo)
+{
+  cassandra_rows* rows = NULL;
+  cassandra_future_rows* self = NULL;
+
+  if (zend_parse_parameters_none() == FAILURE)
+    return;
+
+  self = (cassandra_future_rows*) zend_object_store_get_object(getThis() TSRMLS_CC);
+
+  if (self->rows) {
+    rows = (cassandra_rows*) zend_object_store_get_object(self->rows TSRMLS_CC);
+    if (rows->info)
+      php_cassandra_execution_info_to_array(rows->info, return_value TSRMLS_CC);
+    return;
+  }
+
+  if (self->info)
+    php_cassandra_execution_info_to_array(self->info, return_value TSRMLS_CC);
+}
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_none, 0, ZEND_RETURN_VALUE, 0)
+ZEND_END_ARG_INFO()
+
 ZEND_BEGIN_ARG_INFO_EX(arginfo_timeout, 0, ZEND_RETURN_VALUE, 0)
   ZEND_ARG_INFO(0, timeout)
 ZEND_END_ARG_INFO()
 
 static zend_function_entry cassandra_future_rows_methods[] = {
-  PHP_ME(FutureRows, get, arginfo_timeout, ZEND_ACC_PUBLIC)
+  PHP_ME(FutureRows, get,           arginfo_timeout, ZEND_ACC_PUBLIC)
+  PHP_ME(FutureRows, executionInfo, arginfo_none,    ZEND_ACC_PUBLIC)
   PHP_FE_END
 };
 
@@ -143,6 +191,9 @@ php_cassandra_future_rows_new(zend_class_entry* class_type TSRMLS_DC)
   future->rows      = NULL;
   future->statement = NULL;
   future->session   = NULL;
+  future->info      = NULL;
+
+  future->request_size = 0;
 
   retval.handle   = zend_objects_store_put(future,
                       (zend_objects_store_dtor_t) zend_objects_destroy_object,
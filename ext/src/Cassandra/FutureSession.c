@@ -1,6 +1,7 @@
 #include "php_cassandra.h"
 
 #include "util/future.h"
+#include "util/psession.h"
 
 zend_class_entry *cassandra_future_session_ce = NULL;
 
@@ -44,10 +45,7 @@ PHP_METHOD(FutureSession, get)
       future->exception_message = estrndup(message, message_len);
       future->exception_code    = rc;
 
-      if (zend_hash_del(&EG(persistent_list), future->hash_key, future->hash_key_len + 1) == SUCCESS) {
-        future->session = NULL;
-        future->future  = NULL;
-      }
+      php_cassandra_psession_failed(future->psession, future->future);
 
       zend_throw_exception_ex(exception_class(future->exception_code),
         future->exception_code TSRMLS_CC, future->exception_message);
@@ -60,11 +58,19 @@ PHP_METHOD(FutureSession, get)
   }
 
   object_init_ex(return_value, cassandra_default_session_ce);
+  session = (cassandra_session*) zend_object_store_get_object(return_value TSRMLS_CC);
+  session->session  = future->session;
+  session->persist  = future->persist;
+  session->psession = future->psession;
+  session->rate_limit = future->rate_limit;
+
+  if (future->profiles) {
+    session->profiles = future->profiles;
+    Z_ADDREF_P(session->profiles);
+  }
+
   future->default_session = return_value;
   Z_ADDREF_P(future->default_session);
-  session = (cassandra_session*) zend_object_store_get_object(return_value TSRMLS_CC);
-  session->session = future->session;
-  session->persist = future->persist;
 }
 
 ZEND_BEGIN_ARG_INFO_EX(arginfo_timeout, 0, ZEND_RETURN_VALUE, 0)
@@ -112,6 +118,9 @@ php_cassandra_future_session_free(void *object TSRMLS_DC)
   if (future->exception_message)
     efree(future->exception_message);
 
+  if (future->profiles)
+    zval_ptr_dtor(&future->profiles);
+
   efree(future);
 }
 
@@ -127,6 +136,7 @@ php_cassandra_future_session_new(zend_class_entry* class_type TSRMLS_DC)
   future->exception_message = NULL;
   future->hash_key          = NULL;
   future->persist           = 0;
+  future->psession          = NULL;
 
   zend_object_std_init(&future->zval, class_type TSRMLS_CC);
   object_properties_init(&future->zval, class_type);
@@ -1,5 +1,6 @@
 #include "php_cassandra.h"
 #include "util/collections.h"
+#include "util/iterator.h"
 #include "Map.h"
 
 zend_class_entry *cassandra_map_ce = NULL;
@@ -454,6 +455,36 @@ php_cassandra_map_free(void *object TSRMLS_DC)
   efree(map);
 }
 
+/* Keys and values of a map are stored under the same hash keys, the key of
+ * the current value is looked up by its hash key. */
+static void
+php_cassandra_map_iterator_key(php_cassandra_iterator* iterator, zval* key TSRMLS_DC)
+{
+  cassandra_map* map =
+    (cassandra_map*) zend_object_store_get_object((zval*) iterator->it.data TSRMLS_CC);
+  char* hash_key;
+  uint hash_key_len;
+  ulong index;
+  zval** current;
+
+  if (zend_hash_get_current_key_ex(iterator->values, &hash_key, &hash_key_len, &index, 0,
+                                   &iterator->pos) == HASH_KEY_IS_STRING &&
+      zend_hash_find(&map->keys, hash_key, hash_key_len, (void**) &current) == SUCCESS) {
+    ZVAL_ZVAL(key, *current, 1, 0);
+  } else {
+    ZVAL_NULL(key);
+  }
+}
+
+static zend_object_iterator*
+php_cassandra_map_get_iterator(zend_class_entry* ce, zval* object, int by_ref TSRMLS_DC)
+{
+  cassandra_map* map = (cassandra_map*) zend_object_store_get_object(object TSRMLS_CC);
+
+  return php_cassandra_iterator_new(object, &map->values,
+                                    php_cassandra_map_iterator_key, by_ref TSRMLS_CC);
+}
+
 static zend_object_value
 php_cassandra_map_new(zend_class_entry* class_type TSRMLS_DC)
 {
@@ -490,5 +521,6 @@ void cassandra_define_Map(TSRMLS_D)
   cassandra_map_handlers.compare_objects = php_cassandra_map_compare;
   cassandra_map_ce->ce_flags |= ZEND_ACC_FINAL_CLASS;
   cassandra_map_ce->create_object = php_cassandra_map_new;
+  cassandra_map_ce->get_iterator  = php_cassandra_map_get_iterator;
   zend_class_implements(cassandra_map_ce TSRMLS_CC, 3, spl_ce_Countable, zend_ce_iterator, zend_ce_arrayaccess);
 }
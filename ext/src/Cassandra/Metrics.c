@@ -0,0 +1,29 @@
+#include "php_cassandra.h"
+#include "util/metrics.h"
+
+zend_class_entry* cassandra_metrics_ce = NULL;
+
+PHP_METHOD(Metrics, export)
+{
+  if (zend_parse_parameters_none() == FAILURE)
+    return;
+
+  php_cassandra_export_metrics(return_value TSRMLS_CC);
+}
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_none, 0, ZEND_RETURN_VALUE, 0)
+ZEND_END_ARG_INFO()
+
+static zend_function_entry cassandra_metrics_methods[] = {
+  PHP_ME(Metrics, export, arginfo_none, ZEND_ACC_PUBLIC|ZEND_ACC_STATIC)
+  PHP_FE_END
+};
+
+void cassandra_define_Metrics(TSRMLS_D)
+{
+  zend_class_entry ce;
+
+  INIT_CLASS_ENTRY(ce, "Cassandra\\Metrics", cassandra_metrics_methods);
+  cassandra_metrics_ce = zend_register_internal_class(&ce TSRMLS_CC);
+  cassandra_metrics_ce->ce_flags |= ZEND_ACC_FINAL_CLASS;
+}
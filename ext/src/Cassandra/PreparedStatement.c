@@ -1,9 +1,90 @@
 #include "php_cassandra.h"
+#include "src/Cassandra/PreparedStatement.h"
 
 zend_class_entry *cassandra_prepared_statement_ce = NULL;
 
 ZEND_EXTERN_MODULE_GLOBALS(cassandra)
 
+/* Maps the names of the parameters, as found in the metadata, to their
+ * first index once, rather than have the driver search the metadata for
+ * every value bound by name. Further parameters with the same name are
+ * chained through parameters_next, where 0 ends the chain. */
+void
+php_cassandra_prepared_statement_index(cassandra_prepared_statement* statement)
+{
+#if CURRENT_CPP_DRIVER_VERSION >= CPP_DRIVER_VERSION(2, 3, 0)
+  const char* name;
+  size_t name_length;
+  char* key;
+  size_t count = 0;
+  size_t index;
+  size_t* first;
+
+  while (cass_prepared_parameter_name(statement->prepared, count,
+                                      &name, &name_length) == CASS_OK)
+    count++;
+
+  if (count == 0)
+    return;
+
+  ALLOC_HASHTABLE(statement->parameters);
+  zend_hash_init(statement->parameters, count, NULL, NULL, 0);
+  statement->parameters_next = (size_t*) ecalloc(count, sizeof(size_t));
+
+  for (index = count; index-- > 0;) {
+    cass_prepared_parameter_name(statement->prepared, index, &name, &name_length);
+
+    /* The names in the metadata are not NUL-terminated, hash keys must be */
+    key = estrndup(name, name_length);
+
+    if (zend_hash_find(statement->parameters, key, name_length + 1, (void**) &first) == SUCCESS)
+      statement->parameters_next[index] = *first;
+
+    zend_hash_update(statement->parameters, key, name_length + 1,
+                     &index, sizeof(size_t), NULL);
+
+    efree(key);
+  }
+#endif
+}
+
+/* Finds the first index of a parameter. Like identifiers in CQL, a quoted
+ * name is matched as is and any other name is lowercased first, so a
+ * parameter with uppercase letters can only be bound by its quoted name. */
+int
+php_cassandra_prepared_statement_parameter(cassandra_prepared_statement* statement,
+                                           const char* name, size_t name_length,
+                                           size_t* index)
+{
+  size_t* found;
+  char* key = NULL;
+  size_t i;
+  int result;
+
+  if (name_length >= 2 && name[0] == '"' && name[name_length - 1] == '"') {
+    name_length -= 2;
+    key = estrndup(name + 1, name_length);
+  } else {
+    for (i = 0; i < name_length; i++) {
+      if (name[i] >= 'A' && name[i] <= 'Z') {
+        key = zend_str_tolower_dup(name, name_length);
+        break;
+      }
+    }
+  }
+
+  result = zend_hash_find(statement->parameters, key ? key : name, name_length + 1,
+                          (void**) &found);
+
+  if (key)
+    efree(key);
+
+  if (result == SUCCESS)
+    *index = *found;
+
+  return result;
+}
+
 PHP_METHOD(PreparedStatement, __construct)
 {
 }
@@ -40,6 +121,22 @@ php_cassandra_prepared_statement_free(void *object TSRMLS_DC)
   if (statement->prepared)
     cass_prepared_free(statement->prepared);
 
+  if (statement->cql) {
+    efree(statement->cql);
+    statement->cql = NULL;
+  }
+
+  if (statement->parameters) {
+    zend_hash_destroy(statement->parameters);
+    FREE_HASHTABLE(statement->parameters);
+    statement->parameters = NULL;
+  }
+
+  if (statement->parameters_next) {
+    efree(statement->parameters_next);
+    statement->parameters_next = NULL;
+  }
+
   zend_object_std_dtor(&statement->zval TSRMLS_CC);
   efree(statement);
 }
@@ -56,7 +153,10 @@ php_cassandra_prepared_statement_new(zend_class_entry* class_type TSRMLS_DC)
   object_properties_init(&statement->zval, class_type);
 
   statement->type = CASSANDRA_PREPARED_STATEMENT;
-  statement->prepared = NULL;
+  statement->prepared        = NULL;
+  statement->cql             = NULL;
+  statement->parameters      = NULL;
+  statement->parameters_next = NULL;
 
   retval.handle   = zend_objects_store_put(statement,
                       (zend_objects_store_dtor_t) zend_objects_destroy_object,
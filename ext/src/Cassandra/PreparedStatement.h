@@ -0,0 +1,9 @@
+#ifndef PHP_CASSANDRA_PREPARED_STATEMENT_H
+#define PHP_CASSANDRA_PREPARED_STATEMENT_H
+
+void php_cassandra_prepared_statement_index(cassandra_prepared_statement* statement);
+int  php_cassandra_prepared_statement_parameter(cassandra_prepared_statement* statement,
+                                                const char* name, size_t name_length,
+                                                size_t* index);
+
+#endif /* PHP_CASSANDRA_PREPARED_STATEMENT_H */
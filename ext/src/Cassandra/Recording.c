@@ -0,0 +1,33 @@
+#include "php_cassandra.h"
+#include "util/recording.h"
+
+zend_class_entry* cassandra_recording_ce = NULL;
+
+PHP_METHOD(Recording, replay)
+{
+  char* filename;
+  int filename_len;
+
+  if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "s", &filename, &filename_len) == FAILURE)
+    return;
+
+  php_cassandra_replay(filename, return_value TSRMLS_CC);
+}
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_replay, 0, ZEND_RETURN_VALUE, 1)
+  ZEND_ARG_INFO(0, filename)
+ZEND_END_ARG_INFO()
+
+static zend_function_entry cassandra_recording_methods[] = {
+  PHP_ME(Recording, replay, arginfo_replay, ZEND_ACC_PUBLIC|ZEND_ACC_STATIC)
+  PHP_FE_END
+};
+
+void cassandra_define_Recording(TSRMLS_D)
+{
+  zend_class_entry ce;
+
+  INIT_CLASS_ENTRY(ce, "Cassandra\\Recording", cassandra_recording_methods);
+  cassandra_recording_ce = zend_register_internal_class(&ce TSRMLS_CC);
+  cassandra_recording_ce->ce_flags |= ZEND_ACC_FINAL_CLASS;
+}
@@ -0,0 +1,80 @@
+#include "php_cassandra.h"
+#include "src/Cassandra/RetryPolicy.h"
+
+zend_class_entry *cassandra_retry_policy_ce = NULL;
+
+static zend_function_entry cassandra_retry_policy_methods[] = {
+  PHP_FE_END
+};
+
+static zend_object_handlers cassandra_retry_policy_handlers;
+
+static HashTable*
+php_cassandra_retry_policy_properties(zval *object TSRMLS_DC)
+{
+  HashTable* props = zend_std_get_properties(object TSRMLS_CC);
+
+  return props;
+}
+
+static int
+php_cassandra_retry_policy_compare(zval *obj1, zval *obj2 TSRMLS_DC)
+{
+  if (Z_OBJCE_P(obj1) != Z_OBJCE_P(obj2))
+    return 1; /* different classes */
+
+  return Z_OBJ_HANDLE_P(obj1) != Z_OBJ_HANDLE_P(obj1);
+}
+
+static void
+php_cassandra_retry_policy_free(void *object TSRMLS_DC)
+{
+  cassandra_retry_policy* self = (cassandra_retry_policy*) object;
+
+  zend_object_std_dtor(&self->zval TSRMLS_CC);
+
+  if (self->policy)
+    cass_retry_policy_free(self->policy);
+
+  if (self->name)
+    efree(self->name);
+
+  efree(self);
+}
+
+/* Shared by all retry policy classes, each of which creates its driver
+ * policy once the object exists. */
+zend_object_value
+php_cassandra_retry_policy_new(zend_class_entry* class_type TSRMLS_DC)
+{
+  zend_object_value retval;
+  cassandra_retry_policy *self;
+
+  self = (cassandra_retry_policy*) ecalloc(1, sizeof(cassandra_retry_policy));
+
+  zend_object_std_init(&self->zval, class_type TSRMLS_CC);
+  object_properties_init(&self->zval, class_type);
+
+  self->policy = NULL;
+  self->name   = NULL;
+
+  retval.handle   = zend_objects_store_put(self,
+                      (zend_objects_store_dtor_t) zend_objects_destroy_object,
+                      php_cassandra_retry_policy_free, NULL TSRMLS_CC);
+  retval.handlers = &cassandra_retry_policy_handlers;
+
+  return retval;
+}
+
+void cassandra_define_RetryPolicy(TSRMLS_D)
+{
+  zend_class_entry ce;
+
+  INIT_CLASS_ENTRY(ce, "Cassandra\\RetryPolicy", cassandra_retry_policy_methods);
+  cassandra_retry_policy_ce = zend_register_internal_class(&ce TSRMLS_CC);
+  cassandra_retry_policy_ce->ce_flags |= ZEND_ACC_INTERFACE;
+
+  memcpy(&cassandra_retry_policy_handlers, zend_get_std_object_handlers(), sizeof(zend_object_handlers));
+  cassandra_retry_policy_handlers.get_properties  = php_cassandra_retry_policy_properties;
+  cassandra_retry_policy_handlers.compare_objects = php_cassandra_retry_policy_compare;
+}
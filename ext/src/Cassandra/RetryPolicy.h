@@ -0,0 +1,6 @@
+#ifndef PHP_CASSANDRA_RETRY_POLICY_H
+#define PHP_CASSANDRA_RETRY_POLICY_H
+
+zend_object_value php_cassandra_retry_policy_new(zend_class_entry* class_type TSRMLS_DC);
+
+#endif /* PHP_CASSANDRA_RETRY_POLICY_H */
@@ -0,0 +1,32 @@
+#include "php_cassandra.h"
+#include "src/Cassandra/RetryPolicy.h"
+
+zend_class_entry *cassandra_retry_policy_downgrading_consistency_ce = NULL;
+
+static zend_function_entry cassandra_retry_policy_downgrading_consistency_methods[] = {
+  PHP_FE_END
+};
+
+static zend_object_value
+php_cassandra_retry_policy_downgrading_consistency_new(zend_class_entry* class_type TSRMLS_DC)
+{
+  zend_object_value retval = php_cassandra_retry_policy_new(class_type TSRMLS_CC);
+  cassandra_retry_policy* self =
+    (cassandra_retry_policy*) zend_object_store_get_object_by_handle(retval.handle TSRMLS_CC);
+
+  self->policy = cass_retry_policy_downgrading_consistency_new();
+  self->name   = estrdup("downgrading_consistency");
+
+  return retval;
+}
+
+void cassandra_define_RetryPolicyDowngradingConsistency(TSRMLS_D)
+{
+  zend_class_entry ce;
+
+  INIT_CLASS_ENTRY(ce, "Cassandra\\RetryPolicy\\DowngradingConsistency", cassandra_retry_policy_downgrading_consistency_methods);
+  cassandra_retry_policy_downgrading_consistency_ce = zend_register_internal_class(&ce TSRMLS_CC);
+  zend_class_implements(cassandra_retry_policy_downgrading_consistency_ce TSRMLS_CC, 1, cassandra_retry_policy_ce);
+  cassandra_retry_policy_downgrading_consistency_ce->ce_flags     |= ZEND_ACC_FINAL_CLASS;
+  cassandra_retry_policy_downgrading_consistency_ce->create_object = php_cassandra_retry_policy_downgrading_consistency_new;
+}
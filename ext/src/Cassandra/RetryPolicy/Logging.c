@@ -0,0 +1,52 @@
+#include "php_cassandra.h"
+#include "src/Cassandra/RetryPolicy.h"
+
+zend_class_entry *cassandra_retry_policy_logging_ce = NULL;
+
+PHP_METHOD(RetryPolicyLogging, __construct)
+{
+  zval* child_policy = NULL;
+  cassandra_retry_policy* self = NULL;
+  cassandra_retry_policy* child = NULL;
+
+  if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "O", &child_policy,
+                            cassandra_retry_policy_ce) == FAILURE) {
+    return;
+  }
+
+  self  = (cassandra_retry_policy*) zend_object_store_get_object(getThis() TSRMLS_CC);
+  child = (cassandra_retry_policy*) zend_object_store_get_object(child_policy TSRMLS_CC);
+
+  if (!child->policy) {
+    INVALID_ARGUMENT(child_policy, "an initialized instance of Cassandra\\RetryPolicy");
+  }
+
+  if (self->policy)
+    cass_retry_policy_free(self->policy);
+  if (self->name)
+    efree(self->name);
+
+  /* The driver keeps its own reference to the child policy */
+  self->policy = cass_retry_policy_logging_new(child->policy);
+  spprintf(&self->name, 0, "logging(%s)", child->name);
+}
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo__construct, 0, ZEND_RETURN_VALUE, 1)
+  ZEND_ARG_OBJ_INFO(0, childPolicy, Cassandra\\RetryPolicy, 0)
+ZEND_END_ARG_INFO()
+
+static zend_function_entry cassandra_retry_policy_logging_methods[] = {
+  PHP_ME(RetryPolicyLogging, __construct, arginfo__construct, ZEND_ACC_PUBLIC | ZEND_ACC_CTOR)
+  PHP_FE_END
+};
+
+void cassandra_define_RetryPolicyLogging(TSRMLS_D)
+{
+  zend_class_entry ce;
+
+  INIT_CLASS_ENTRY(ce, "Cassandra\\RetryPolicy\\Logging", cassandra_retry_policy_logging_methods);
+  cassandra_retry_policy_logging_ce = zend_register_internal_class(&ce TSRMLS_CC);
+  zend_class_implements(cassandra_retry_policy_logging_ce TSRMLS_CC, 1, cassandra_retry_policy_ce);
+  cassandra_retry_policy_logging_ce->ce_flags     |= ZEND_ACC_FINAL_CLASS;
+  cassandra_retry_policy_logging_ce->create_object = php_cassandra_retry_policy_new;
+}
@@ -1,5 +1,9 @@
 #include "php_cassandra.h"
+#include "util/execution_info.h"
 #include "util/future.h"
+#include "util/iterator.h"
+#include "util/metrics.h"
+#include "util/rate_limit.h"
 #include "util/ref.h"
 #include "util/result.h"
 
@@ -196,6 +200,8 @@ PHP_METHOD(Rows, nextPage)
   const CassResult* result = NULL;
   cassandra_rows* rows = NULL;
   cassandra_future_rows* future_rows = NULL;
+  cassandra_execution_info* info = NULL;
+  size_t result_size = 0;
 
   cassandra_rows* self = (cassandra_rows*) zend_object_store_get_object(getThis() TSRMLS_CC);
 
@@ -221,11 +227,17 @@ PHP_METHOD(Rows, nextPage)
       return;
     }
 
+    PHP_CASSANDRA_EXECUTION_INFO_MARK(future_rows->info, response);
+
     if (php_cassandra_future_is_error(future_rows->future TSRMLS_CC) == FAILURE) {
+      PHP_CASSANDRA_COUNTER_ADD(request_errors, 1);
+      php_cassandra_execution_info_attach(future_rows->info TSRMLS_CC);
       return;
     }
 
     result = cass_future_get_result(future_rows->future);
+    info = future_rows->info;
+    future_rows->info = NULL;
   } else {
     if (self->result == NULL) {
       return;
@@ -234,13 +246,27 @@ PHP_METHOD(Rows, nextPage)
     ASSERT_SUCCESS(cass_statement_set_paging_state((CassStatement*) self->statement->data, self->result));
 
     session = (cassandra_session*) zend_object_store_get_object(self->session TSRMLS_CC);
+
+    if (php_cassandra_rate_limit_acquire(&session->rate_limit, self->request_size TSRMLS_CC) == FAILURE)
+      return;
+
+    info = php_cassandra_execution_info_new(TSRMLS_C);
+    PHP_CASSANDRA_EXECUTION_INFO_MARK(info, submit);
+
     future = cass_session_execute(session->session, (CassStatement*) self->statement->data);
+    PHP_CASSANDRA_COUNTER_ADD(requests, 1);
 
     if (php_cassandra_future_wait_timed(future, timeout TSRMLS_CC) == FAILURE) {
+      php_cassandra_execution_info_free(&info);
       return;
     }
 
+    PHP_CASSANDRA_EXECUTION_INFO_MARK(info, response);
+
     if (php_cassandra_future_is_error(future TSRMLS_CC) == FAILURE) {
+      PHP_CASSANDRA_COUNTER_ADD(request_errors, 1);
+      php_cassandra_execution_info_attach(info TSRMLS_CC);
+      php_cassandra_execution_info_free(&info);
       return;
     }
 
@@ -249,6 +275,7 @@ PHP_METHOD(Rows, nextPage)
   }
 
   if (!result) {
+    php_cassandra_execution_info_free(&info);
     zend_throw_exception_ex(cassandra_runtime_exception_ce, 0 TSRMLS_CC,
                             "Future doesn't contain a result.");
     return;
@@ -258,13 +285,21 @@ PHP_METHOD(Rows, nextPage)
   object_init_ex(self->next_page, cassandra_rows_ce);
   rows = (cassandra_rows*) zend_object_store_get_object(self->next_page TSRMLS_CC);
 
-  if (php_cassandra_get_result(result, &rows->rows TSRMLS_CC) == FAILURE) {
+  if (php_cassandra_get_result(result, &rows->rows,
+                               info ? &result_size : NULL TSRMLS_CC) == FAILURE) {
+    php_cassandra_execution_info_free(&info);
     cass_result_free(result);
     zval_dtor(self->next_page);
     self->next_page = NULL;
     return;
   }
 
+  if (info) {
+    PHP_CASSANDRA_EXECUTION_INFO_MARK(info, decode_end);
+    php_cassandra_execution_info_result(info, result, result_size);
+    rows->info = info;
+  }
+
   if (self->future_next_page) {
     zval_ptr_dtor(&self->future_next_page);
     self->future_next_page = NULL;
@@ -272,9 +307,10 @@ PHP_METHOD(Rows, nextPage)
 
   if (cass_result_has_more_pages(result)) {
     Z_ADDREF_P(self->session);
-    rows->statement = php_cassandra_add_ref(self->statement);
-    rows->session   = self->session;
-    rows->result    = result;
+    rows->statement    = php_cassandra_add_ref(self->statement);
+    rows->session      = self->session;
+    rows->result       = result;
+    rows->request_size = self->request_size;
   } else {
     cass_result_free(result);
   }
@@ -290,6 +326,7 @@ PHP_METHOD(Rows, nextPageAsync)
   CassFuture* future = NULL;
   cassandra_future_rows* future_rows = NULL;
   cassandra_future_value* future_value;
+  cassandra_execution_info* info = NULL;
 
   if (zend_parse_parameters_none() == FAILURE)
     return;
@@ -316,21 +353,44 @@ PHP_METHOD(Rows, nextPageAsync)
   ASSERT_SUCCESS(cass_statement_set_paging_state((CassStatement*) self->statement->data, self->result));
 
   session = (cassandra_session*) zend_object_store_get_object(self->session TSRMLS_CC);
+
+  if (php_cassandra_rate_limit_acquire(&session->rate_limit, self->request_size TSRMLS_CC) == FAILURE)
+    return;
+
+  info = php_cassandra_execution_info_new(TSRMLS_C);
+  PHP_CASSANDRA_EXECUTION_INFO_MARK(info, submit);
+
   future = cass_session_execute(session->session, (CassStatement*) self->statement->data);
+  PHP_CASSANDRA_COUNTER_ADD(requests, 1);
 
   MAKE_STD_ZVAL(self->future_next_page);
   object_init_ex(self->future_next_page, cassandra_future_rows_ce);
   future_rows = (cassandra_future_rows*) zend_object_store_get_object(self->future_next_page TSRMLS_CC);
 
   Z_ADDREF_P(self->session);
-  future_rows->session   = self->session;
-  future_rows->statement = php_cassandra_add_ref(self->statement);
-  future_rows->future    = future;
+  future_rows->session      = self->session;
+  future_rows->statement    = php_cassandra_add_ref(self->statement);
+  future_rows->future       = future;
+  future_rows->info         = info;
+  future_rows->request_size = self->request_size;
 
   php_cassandra_rows_clear(self);
   RETURN_ZVAL(self->future_next_page, 1, 0);
 }
 
+PHP_METHOD(Rows, executionInfo)
+{
+  cassandra_rows* self = NULL;
+
+  if (zend_parse_parameters_none() == FAILURE)
+    return;
+
+  self = (cassandra_rows*) zend_object_store_get_object(getThis() TSRMLS_CC);
+
+  if (self->info)
+    php_cassandra_execution_info_to_array(self->info, return_value TSRMLS_CC);
+}
+
 PHP_METHOD(Rows, first)
 {
   HashPointer ptr;
@@ -384,6 +444,7 @@ static zend_function_entry cassandra_rows_methods[] = {
   PHP_ME(Rows, nextPage,      arginfo_timeout, ZEND_ACC_PUBLIC)
   PHP_ME(Rows, nextPageAsync, arginfo_none,    ZEND_ACC_PUBLIC)
   PHP_ME(Rows, first,         arginfo_none,    ZEND_ACC_PUBLIC)
+  PHP_ME(Rows, executionInfo, arginfo_none,    ZEND_ACC_PUBLIC)
   PHP_FE_END
 };
 
@@ -429,9 +490,26 @@ php_cassandra_rows_free(void *object TSRMLS_DC)
     self->future_next_page = NULL;
   }
 
+  php_cassandra_execution_info_free(&self->info);
+
   efree(self);
 }
 
+static zend_object_iterator*
+php_cassandra_rows_get_iterator(zend_class_entry* ce, zval* object, int by_ref TSRMLS_DC)
+{
+  cassandra_rows* self = (cassandra_rows*) zend_object_store_get_object(object TSRMLS_CC);
+
+  if (!self->rows) {
+    zend_throw_exception_ex(cassandra_logic_exception_ce, 0 TSRMLS_CC,
+                            "Rows cannot be iterated before they are loaded");
+    return NULL;
+  }
+
+  return php_cassandra_iterator_new(object, Z_ARRVAL_P(self->rows),
+                                    php_cassandra_iterator_key_hash, by_ref TSRMLS_CC);
+}
+
 static zend_object_value
 php_cassandra_rows_new(zend_class_entry* class_type TSRMLS_DC)
 {
@@ -448,6 +526,9 @@ php_cassandra_rows_new(zend_class_entry* class_type TSRMLS_DC)
   self->session   = NULL;
   self->rows      = NULL;
   self->next_page = NULL;
+  self->info      = NULL;
+
+  self->request_size = 0;
 
   retval.handle   = zend_objects_store_put(self,
                       (zend_objects_store_dtor_t) zend_objects_destroy_object,
@@ -463,9 +544,10 @@ void cassandra_define_Rows(TSRMLS_D)
 
   INIT_CLASS_ENTRY(ce, "Cassandra\\Rows", cassandra_rows_methods);
   cassandra_rows_ce = zend_register_internal_class(&ce TSRMLS_CC);
-  zend_class_implements(cassandra_rows_ce TSRMLS_CC, 2, zend_ce_iterator, zend_ce_arrayaccess);
   cassandra_rows_ce->ce_flags     |= ZEND_ACC_FINAL_CLASS;
   cassandra_rows_ce->create_object = php_cassandra_rows_new;
+  cassandra_rows_ce->get_iterator  = php_cassandra_rows_get_iterator;
+  zend_class_implements(cassandra_rows_ce TSRMLS_CC, 2, zend_ce_iterator, zend_ce_arrayaccess);
 
   memcpy(&cassandra_rows_handlers, zend_get_std_object_handlers(), sizeof(zend_object_handlers));
   cassandra_rows_handlers.get_properties  = php_cassandra_rows_properties;
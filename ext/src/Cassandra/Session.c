@@ -4,7 +4,7 @@ zend_class_entry *cassandra_session_ce = NULL;
 
 ZEND_BEGIN_ARG_INFO_EX(arginfo_execute, 0, ZEND_RETURN_VALUE, 1)
   ZEND_ARG_OBJ_INFO(0, statement, Cassandra\\Statement, 0)
-  ZEND_ARG_OBJ_INFO(0, options, Cassandra\\ExecutionOptions, 0)
+  ZEND_ARG_INFO(0, options)
 ZEND_END_ARG_INFO()
 
 ZEND_BEGIN_ARG_INFO_EX(arginfo_prepare, 0, ZEND_RETURN_VALUE, 1)
@@ -27,6 +27,8 @@ static zend_function_entry cassandra_session_methods[] = {
   PHP_ABSTRACT_ME(Session, close, arginfo_timeout)
   PHP_ABSTRACT_ME(Session, closeAsync, arginfo_none)
   PHP_ABSTRACT_ME(Session, schema, arginfo_none)
+  PHP_ABSTRACT_ME(Session, schemaVersion, arginfo_none)
+  PHP_ABSTRACT_ME(Session, metrics, arginfo_none)
   PHP_FE_END
 };
 
@@ -1,5 +1,6 @@
 #include "php_cassandra.h"
 #include "util/collections.h"
+#include "util/iterator.h"
 #include "src/Cassandra/Set.h"
 
 zend_class_entry *cassandra_set_ce = NULL;
@@ -313,6 +314,15 @@ php_cassandra_set_free(void *object TSRMLS_DC)
   efree(set);
 }
 
+static zend_object_iterator*
+php_cassandra_set_get_iterator(zend_class_entry* ce, zval* object, int by_ref TSRMLS_DC)
+{
+  cassandra_set* set = (cassandra_set*) zend_object_store_get_object(object TSRMLS_CC);
+
+  return php_cassandra_iterator_new(object, &set->values,
+                                    php_cassandra_iterator_key_index, by_ref TSRMLS_CC);
+}
+
 static zend_object_value
 php_cassandra_set_new(zend_class_entry* class_type TSRMLS_DC)
 {
@@ -348,5 +358,6 @@ void cassandra_define_Set(TSRMLS_D)
   cassandra_set_handlers.compare_objects = php_cassandra_set_compare;
   cassandra_set_ce->ce_flags |= ZEND_ACC_FINAL_CLASS;
   cassandra_set_ce->create_object = php_cassandra_set_new;
+  cassandra_set_ce->get_iterator  = php_cassandra_set_get_iterator;
   zend_class_implements(cassandra_set_ce TSRMLS_CC, 2, spl_ce_Countable, zend_ce_iterator);
 }
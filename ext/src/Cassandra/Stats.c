@@ -0,0 +1,29 @@
+#include "php_cassandra.h"
+#include "util/stats.h"
+
+zend_class_entry* cassandra_stats_ce = NULL;
+
+PHP_METHOD(Stats, statements)
+{
+  if (zend_parse_parameters_none() == FAILURE)
+    return;
+
+  php_cassandra_stats_statements(return_value TSRMLS_CC);
+}
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_none, 0, ZEND_RETURN_VALUE, 0)
+ZEND_END_ARG_INFO()
+
+static zend_function_entry cassandra_stats_methods[] = {
+  PHP_ME(Stats, statements, arginfo_none, ZEND_ACC_PUBLIC|ZEND_ACC_STATIC)
+  PHP_FE_END
+};
+
+void cassandra_define_Stats(TSRMLS_D)
+{
+  zend_class_entry ce;
+
+  INIT_CLASS_ENTRY(ce, "Cassandra\\Stats", cassandra_stats_methods);
+  cassandra_stats_ce = zend_register_internal_class(&ce TSRMLS_CC);
+  cassandra_stats_ce->ce_flags |= ZEND_ACC_FINAL_CLASS;
+}
@@ -50,7 +50,7 @@ PHP_METHOD(Type, collection)
 
   scalar = (cassandra_type_scalar*) zend_object_store_get_object(type TSRMLS_CC);
   ztype  = php_cassandra_type_collection(scalar->type TSRMLS_CC);
-  RETURN_ZVAL(ztype, 0, 1);
+  RETURN_ZVAL(ztype, 1, 1);
 }
 
 PHP_METHOD(Type, set)
@@ -87,7 +87,7 @@ PHP_METHOD(Type, set)
 
   scalar = (cassandra_type_scalar*) zend_object_store_get_object(type TSRMLS_CC);
   ztype  = php_cassandra_type_set(scalar->type TSRMLS_CC);
-  RETURN_ZVAL(ztype, 0, 1);
+  RETURN_ZVAL(ztype, 1, 1);
 }
 
 PHP_METHOD(Type, map)
@@ -151,7 +151,7 @@ PHP_METHOD(Type, map)
   key_scalar   = (cassandra_type_scalar*) zend_object_store_get_object(key_type TSRMLS_CC);
   value_scalar = (cassandra_type_scalar*) zend_object_store_get_object(value_type TSRMLS_CC);
   ztype        = php_cassandra_type_map(key_scalar->type, value_scalar->type TSRMLS_CC);
-  RETURN_ZVAL(ztype, 0, 1);
+  RETURN_ZVAL(ztype, 1, 1);
 }
 
 ZEND_BEGIN_ARG_INFO_EX(arginfo_none, 0, ZEND_RETURN_VALUE, 0)
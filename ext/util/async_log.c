@@ -0,0 +1,150 @@
+#include "php_cassandra.h"
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+#include <uv.h>
+#include "util/async_log.h"
+
+/* Messages are handed off to a dedicated writer thread through a bounded
+ * queue so that callers never wait on the log file. When the writer falls
+ * behind, new messages are dropped and counted instead of blocking. */
+#define PHP_CASSANDRA_ASYNC_LOG_QUEUE_SIZE 1024
+
+typedef struct {
+  const char* severity;
+  char*       message;
+} php_cassandra_async_log_entry;
+
+static uv_once_t   async_log_once = UV_ONCE_INIT;
+static uv_mutex_t  async_log_lock;
+static uv_cond_t   async_log_cond;
+static uv_thread_t async_log_thread;
+static int         async_log_running = 0;
+static int         async_log_stopping = 0;
+static size_t      async_log_head = 0;
+static size_t      async_log_count = 0;
+static size_t      async_log_dropped = 0;
+static php_cassandra_async_log_entry async_log_queue[PHP_CASSANDRA_ASYNC_LOG_QUEUE_SIZE];
+#ifndef _WIN32
+static pid_t       async_log_pid = 0;
+#endif
+
+static void
+php_cassandra_async_log_initialize()
+{
+  uv_mutex_init(&async_log_lock);
+  uv_cond_init(&async_log_cond);
+#ifndef _WIN32
+  async_log_pid = getpid();
+#endif
+}
+
+static void
+php_cassandra_async_log_check_fork()
+{
+#ifndef _WIN32
+  if (async_log_pid == getpid())
+    return;
+
+  /* The writer thread only exists in the parent, which also still owns the
+   * queued messages. A forked child starts over with an empty queue and
+   * spawns its own writer. The lock may have been held by a thread of the
+   * parent while forking, so it is not reused either. Only the thread that
+   * forked runs in the child, nothing else can be using the log here. */
+  uv_mutex_init(&async_log_lock);
+  uv_cond_init(&async_log_cond);
+  async_log_running  = 0;
+  async_log_stopping = 0;
+  async_log_head     = 0;
+  async_log_count    = 0;
+  async_log_dropped  = 0;
+  async_log_pid      = getpid();
+#endif
+}
+
+static void
+php_cassandra_async_log_run(void* data)
+{
+  php_cassandra_async_log_entry entry;
+  size_t dropped;
+  char notice[64];
+
+  uv_mutex_lock(&async_log_lock);
+  while (1) {
+    while (async_log_count == 0 && !async_log_stopping)
+      uv_cond_wait(&async_log_cond, &async_log_lock);
+
+    if (async_log_count == 0 && async_log_stopping)
+      break;
+
+    entry   = async_log_queue[async_log_head];
+    dropped = async_log_dropped;
+    async_log_head  = (async_log_head + 1) % PHP_CASSANDRA_ASYNC_LOG_QUEUE_SIZE;
+    async_log_count--;
+    async_log_dropped = 0;
+    uv_mutex_unlock(&async_log_lock);
+
+    if (dropped > 0) {
+      snprintf(notice, sizeof(notice), "%u log messages dropped", (unsigned int) dropped);
+      php_cassandra_log_line("WARN", notice);
+    }
+
+    php_cassandra_log_line(entry.severity, entry.message);
+    free(entry.message);
+
+    uv_mutex_lock(&async_log_lock);
+  }
+  uv_mutex_unlock(&async_log_lock);
+}
+
+void
+php_cassandra_async_log(const char* severity, const char* message)
+{
+  uv_once(&async_log_once, php_cassandra_async_log_initialize);
+  php_cassandra_async_log_check_fork();
+
+  uv_mutex_lock(&async_log_lock);
+
+  if (!async_log_running) {
+    async_log_stopping = 0;
+    if (uv_thread_create(&async_log_thread, php_cassandra_async_log_run, NULL) != 0) {
+      uv_mutex_unlock(&async_log_lock);
+      php_cassandra_log_line(severity, message);
+      return;
+    }
+    async_log_running = 1;
+  }
+
+  if (async_log_count == PHP_CASSANDRA_ASYNC_LOG_QUEUE_SIZE) {
+    async_log_dropped++;
+  } else {
+    size_t tail = (async_log_head + async_log_count) % PHP_CASSANDRA_ASYNC_LOG_QUEUE_SIZE;
+    async_log_queue[tail].severity = severity;
+    async_log_queue[tail].message  = strdup(message);
+    async_log_count++;
+    uv_cond_signal(&async_log_cond);
+  }
+
+  uv_mutex_unlock(&async_log_lock);
+}
+
+void
+php_cassandra_async_log_shutdown()
+{
+  int running;
+
+  uv_once(&async_log_once, php_cassandra_async_log_initialize);
+  php_cassandra_async_log_check_fork();
+
+  uv_mutex_lock(&async_log_lock);
+  running = async_log_running;
+  async_log_stopping = 1;
+  uv_cond_signal(&async_log_cond);
+  uv_mutex_unlock(&async_log_lock);
+
+  /* The writer drains whatever is still queued before exiting. */
+  if (running) {
+    uv_thread_join(&async_log_thread);
+    async_log_running = 0;
+  }
+}
@@ -0,0 +1,7 @@
+#ifndef PHP_CASSANDRA_UTIL_ASYNC_LOG_H
+#define PHP_CASSANDRA_UTIL_ASYNC_LOG_H
+
+void php_cassandra_async_log(const char* severity, const char* message);
+void php_cassandra_async_log_shutdown();
+
+#endif /* PHP_CASSANDRA_UTIL_ASYNC_LOG_H */
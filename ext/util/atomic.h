@@ -0,0 +1,14 @@
+#ifndef PHP_CASSANDRA_UTIL_ATOMIC_H
+#define PHP_CASSANDRA_UTIL_ATOMIC_H
+
+#ifndef _WIN32
+#  define PHP_CASSANDRA_ATOMIC_CAS(ptr, old, value) __sync_bool_compare_and_swap(ptr, old, value)
+#  define PHP_CASSANDRA_ATOMIC_ADD(ptr, value)     __sync_fetch_and_add(ptr, value)
+#else
+#  define PHP_CASSANDRA_ATOMIC_CAS(ptr, old, value) \
+     (InterlockedCompareExchange64((LONGLONG volatile*) (ptr), (value), (old)) == (LONGLONG) (old))
+#  define PHP_CASSANDRA_ATOMIC_ADD(ptr, value) \
+     InterlockedExchangeAdd64((LONGLONG volatile*) (ptr), (value))
+#endif
+
+#endif /* PHP_CASSANDRA_UTIL_ATOMIC_H */
@@ -0,0 +1,299 @@
+#include "php_cassandra.h"
+#include "util/bind.h"
+#include "util/collections.h"
+#include "util/math.h"
+#include "src/Cassandra/PreparedStatement.h"
+
+#define CHECK_RESULT(rc) \
+{ \
+  ASSERT_SUCCESS_VALUE(rc, FAILURE) \
+  return SUCCESS; \
+}
+
+int
+php_cassandra_bind_argument_by_index(CassStatement* statement, size_t index, zval* value TSRMLS_DC)
+{
+  if (Z_TYPE_P(value) == IS_NULL)
+    CHECK_RESULT(cass_statement_bind_null(statement, index));
+
+  if (Z_TYPE_P(value) == IS_STRING)
+    CHECK_RESULT(cass_statement_bind_string_n(statement, index,
+                                             Z_STRVAL_P(value), Z_STRLEN_P(value)));
+
+  if (Z_TYPE_P(value) == IS_DOUBLE)
+    CHECK_RESULT(cass_statement_bind_double(statement, index, Z_DVAL_P(value)));
+
+  if (Z_TYPE_P(value) == IS_LONG)
+    CHECK_RESULT(cass_statement_bind_int32(statement, index, Z_LVAL_P(value)));
+
+  if (Z_TYPE_P(value) == IS_BOOL)
+    CHECK_RESULT(cass_statement_bind_bool(statement, index, Z_BVAL_P(value)));
+
+  if (Z_TYPE_P(value) == IS_OBJECT) {
+    if (instanceof_function(Z_OBJCE_P(value), cassandra_float_ce TSRMLS_CC)) {
+      cassandra_float* float_number = (cassandra_float*) zend_object_store_get_object(value TSRMLS_CC);
+      CHECK_RESULT(cass_statement_bind_float(statement, index, float_number->value));
+    }
+
+    if (instanceof_function(Z_OBJCE_P(value), cassandra_bigint_ce TSRMLS_CC)) {
+      cassandra_bigint* bigint = (cassandra_bigint*) zend_object_store_get_object(value TSRMLS_CC);
+      CHECK_RESULT(cass_statement_bind_int64(statement, index, bigint->value));
+    }
+
+    if (instanceof_function(Z_OBJCE_P(value), cassandra_timestamp_ce TSRMLS_CC)) {
+      cassandra_timestamp* timestamp = (cassandra_timestamp*) zend_object_store_get_object(value TSRMLS_CC);
+      CHECK_RESULT(cass_statement_bind_int64(statement, index, timestamp->timestamp));
+    }
+
+    if (instanceof_function(Z_OBJCE_P(value), cassandra_blob_ce TSRMLS_CC)) {
+      cassandra_blob* blob = (cassandra_blob*) zend_object_store_get_object(value TSRMLS_CC);
+      CHECK_RESULT(cass_statement_bind_bytes(statement, index, blob->data, blob->size));
+    }
+
+    if (instanceof_function(Z_OBJCE_P(value), cassandra_varint_ce TSRMLS_CC)) {
+      cassandra_varint* varint = (cassandra_varint*) zend_object_store_get_object(value TSRMLS_CC);
+      size_t size;
+      cass_byte_t* data = export_twos_complement(varint->value, &size);
+      CassError rc = cass_statement_bind_bytes(statement, index, data, size);
+      free(data);
+      CHECK_RESULT(rc);
+    }
+
+    if (instanceof_function(Z_OBJCE_P(value), cassandra_decimal_ce TSRMLS_CC)) {
+      cassandra_decimal* decimal = (cassandra_decimal*) zend_object_store_get_object(value TSRMLS_CC);
+      size_t size;
+      cass_byte_t* data = (cass_byte_t*) export_twos_complement(decimal->value, &size);
+      CassError rc = cass_statement_bind_decimal(statement, index, data, size, decimal->scale);
+      free(data);
+      CHECK_RESULT(rc);
+    }
+
+    if (instanceof_function(Z_OBJCE_P(value), cassandra_uuid_interface_ce TSRMLS_CC)) {
+      cassandra_uuid* uuid = (cassandra_uuid*) zend_object_store_get_object(value TSRMLS_CC);
+      CHECK_RESULT(cass_statement_bind_uuid(statement, index, uuid->uuid));
+    }
+
+    if (instanceof_function(Z_OBJCE_P(value), cassandra_inet_ce TSRMLS_CC)) {
+      cassandra_inet* inet = (cassandra_inet*) zend_object_store_get_object(value TSRMLS_CC);
+      CHECK_RESULT(cass_statement_bind_inet(statement, index, inet->inet));
+    }
+
+    if (instanceof_function(Z_OBJCE_P(value), cassandra_set_ce TSRMLS_CC)) {
+      CassError rc;
+      CassCollection* collection;
+      cassandra_set* set = (cassandra_set*) zend_object_store_get_object(value TSRMLS_CC);
+      if (!php_cassandra_collection_from_set(set, &collection TSRMLS_CC))
+        return FAILURE;
+
+      rc = cass_statement_bind_collection(statement, index, collection);
+      cass_collection_free(collection);
+      CHECK_RESULT(rc);
+    }
+
+    if (instanceof_function(Z_OBJCE_P(value), cassandra_map_ce TSRMLS_CC)) {
+      CassError rc;
+      CassCollection* collection;
+      cassandra_map* map = (cassandra_map*) zend_object_store_get_object(value TSRMLS_CC);
+      if (!php_cassandra_collection_from_map(map, &collection TSRMLS_CC))
+        return FAILURE;
+
+      rc = cass_statement_bind_collection(statement, index, collection);
+      cass_collection_free(collection);
+      CHECK_RESULT(rc);
+    }
+
+    if (instanceof_function(Z_OBJCE_P(value), cassandra_collection_ce TSRMLS_CC)) {
+      CassError rc;
+      CassCollection* collection;
+      cassandra_collection* coll = (cassandra_collection*) zend_object_store_get_object(value TSRMLS_CC);
+      if (!php_cassandra_collection_from_collection(coll, &collection TSRMLS_CC))
+        return FAILURE;
+
+      rc = cass_statement_bind_collection(statement, index, collection);
+      cass_collection_free(collection);
+      CHECK_RESULT(rc);
+    }
+  }
+
+  return FAILURE;
+}
+
+int
+php_cassandra_bind_argument_by_name(CassStatement* statement, const char* name,
+                                    size_t name_length, zval* value TSRMLS_DC)
+{
+  if (Z_TYPE_P(value) == IS_NULL) {
+    CHECK_RESULT(cass_statement_bind_null_by_name_n(statement, name, name_length));
+  }
+
+  if (Z_TYPE_P(value) == IS_STRING)
+    CHECK_RESULT(cass_statement_bind_string_by_name_n(statement, name, name_length,
+                                                     Z_STRVAL_P(value), Z_STRLEN_P(value)));
+
+  if (Z_TYPE_P(value) == IS_DOUBLE)
+    CHECK_RESULT(cass_statement_bind_double_by_name_n(statement, name, name_length, Z_DVAL_P(value)));
+
+  if (Z_TYPE_P(value) == IS_LONG)
+    CHECK_RESULT(cass_statement_bind_int32_by_name_n(statement, name, name_length, Z_LVAL_P(value)));
+
+  if (Z_TYPE_P(value) == IS_BOOL)
+    CHECK_RESULT(cass_statement_bind_bool_by_name_n(statement, name, name_length, Z_BVAL_P(value)));
+
+  if (Z_TYPE_P(value) == IS_OBJECT) {
+    if (instanceof_function(Z_OBJCE_P(value), cassandra_float_ce TSRMLS_CC)) {
+      cassandra_float* float_number = (cassandra_float*) zend_object_store_get_object(value TSRMLS_CC);
+      CHECK_RESULT(cass_statement_bind_float_by_name_n(statement, name, name_length, float_number->value));
+    }
+
+    if (instanceof_function(Z_OBJCE_P(value), cassandra_bigint_ce TSRMLS_CC)) {
+      cassandra_bigint* bigint = (cassandra_bigint*) zend_object_store_get_object(value TSRMLS_CC);
+      CHECK_RESULT(cass_statement_bind_int64_by_name_n(statement, name, name_length, bigint->value));
+    }
+
+    if (instanceof_function(Z_OBJCE_P(value), cassandra_timestamp_ce TSRMLS_CC)) {
+      cassandra_timestamp* timestamp = (cassandra_timestamp*) zend_object_store_get_object(value TSRMLS_CC);
+      CHECK_RESULT(cass_statement_bind_int64_by_name_n(statement, name, name_length, timestamp->timestamp));
+    }
+
+    if (instanceof_function(Z_OBJCE_P(value), cassandra_blob_ce TSRMLS_CC)) {
+      cassandra_blob* blob = (cassandra_blob*) zend_object_store_get_object(value TSRMLS_CC);
+      CHECK_RESULT(cass_statement_bind_bytes_by_name_n(statement, name, name_length, blob->data, blob->size));
+    }
+
+    if (instanceof_function(Z_OBJCE_P(value), cassandra_varint_ce TSRMLS_CC)) {
+      cassandra_varint* varint = (cassandra_varint*) zend_object_store_get_object(value TSRMLS_CC);
+      size_t size;
+      cass_byte_t* data = (cass_byte_t*) export_twos_complement(varint->value, &size);
+      CassError rc = cass_statement_bind_bytes_by_name_n(statement, name, name_length, data, size);
+      free(data);
+      CHECK_RESULT(rc);
+    }
+
+    if (instanceof_function(Z_OBJCE_P(value), cassandra_decimal_ce TSRMLS_CC)) {
+      cassandra_decimal* decimal = (cassandra_decimal*) zend_object_store_get_object(value TSRMLS_CC);
+      size_t size;
+      cass_byte_t* data = (cass_byte_t*) export_twos_complement(decimal->value, &size);
+      CassError rc = cass_statement_bind_decimal_by_name_n(statement, name, name_length, data, size, decimal->scale);
+      free(data);
+      CHECK_RESULT(rc);
+    }
+
+    if (instanceof_function(Z_OBJCE_P(value), cassandra_uuid_interface_ce TSRMLS_CC)) {
+      cassandra_uuid* uuid = (cassandra_uuid*) zend_object_store_get_object(value TSRMLS_CC);
+      CHECK_RESULT(cass_statement_bind_uuid_by_name_n(statement, name, name_length, uuid->uuid));
+    }
+
+    if (instanceof_function(Z_OBJCE_P(value), cassandra_inet_ce TSRMLS_CC)) {
+      cassandra_inet* inet = (cassandra_inet*) zend_object_store_get_object(value TSRMLS_CC);
+      CHECK_RESULT(cass_statement_bind_inet_by_name_n(statement, name, name_length, inet->inet));
+    }
+
+    if (instanceof_function(Z_OBJCE_P(value), cassandra_set_ce TSRMLS_CC)) {
+      CassError rc;
+      CassCollection* collection;
+      cassandra_set* set = (cassandra_set*) zend_object_store_get_object(value TSRMLS_CC);
+      if (!php_cassandra_collection_from_set(set, &collection TSRMLS_CC))
+        return FAILURE;
+
+      rc = cass_statement_bind_collection_by_name_n(statement, name, name_length, collection);
+      cass_collection_free(collection);
+      CHECK_RESULT(rc);
+    }
+
+    if (instanceof_function(Z_OBJCE_P(value), cassandra_map_ce TSRMLS_CC)) {
+      CassError rc;
+      CassCollection* collection;
+      cassandra_map* map = (cassandra_map*) zend_object_store_get_object(value TSRMLS_CC);
+      if (!php_cassandra_collection_from_map(map, &collection TSRMLS_CC))
+        return FAILURE;
+
+      rc = cass_statement_bind_collection_by_name_n(statement, name, name_length, collection);
+      cass_collection_free(collection);
+      CHECK_RESULT(rc);
+    }
+
+    if (instanceof_function(Z_OBJCE_P(value), cassandra_collection_ce TSRMLS_CC)) {
+      CassError rc;
+      CassCollection* collection;
+      cassandra_collection* coll = (cassandra_collection*) zend_object_store_get_object(value TSRMLS_CC);
+      if (!php_cassandra_collection_from_collection(coll, &collection TSRMLS_CC))
+        return FAILURE;
+
+      rc = cass_statement_bind_collection_by_name_n(statement, name, name_length, collection);
+      cass_collection_free(collection);
+      CHECK_RESULT(rc);
+    }
+  }
+
+  return FAILURE;
+}
+
+/* Binds a named argument of a prepared statement by the indices of its
+ * parameters. */
+int
+php_cassandra_bind_argument_by_parameter(CassStatement* statement,
+                                         cassandra_prepared_statement* prepared,
+                                         const char* name, size_t name_length,
+                                         zval* value TSRMLS_DC)
+{
+  size_t index;
+
+  if (!prepared || !prepared->parameters)
+    return php_cassandra_bind_argument_by_name(statement, name, name_length, value TSRMLS_CC);
+
+  if (php_cassandra_prepared_statement_parameter(prepared, name, name_length, &index) == FAILURE) {
+    zend_throw_exception_ex(cassandra_invalid_argument_exception_ce, 0 TSRMLS_CC,
+                            "Unknown parameter \"%s\"", name);
+    return FAILURE;
+  }
+
+  do {
+    if (php_cassandra_bind_argument_by_index(statement, index, value TSRMLS_CC) == FAILURE)
+      return FAILURE;
+
+    index = prepared->parameters_next[index];
+  } while (index);
+
+  return SUCCESS;
+}
+
+int
+php_cassandra_bind_arguments(CassStatement* statement,
+                             cassandra_prepared_statement* prepared,
+                             HashTable* arguments TSRMLS_DC)
+{
+  HashPointer ptr;
+  ulong       hashIndex = 0;
+  char*       hashKey   = NULL;
+  uint        hashKeyLength;
+  zval**      value;
+  int         rc        = SUCCESS;
+
+  zend_hash_get_pointer(arguments, &ptr);
+  zend_hash_internal_pointer_reset(arguments);
+
+  while (zend_hash_get_current_data(arguments, (void**) &value) == SUCCESS) {
+    switch (zend_hash_get_current_key_ex(arguments, &hashKey, &hashKeyLength, &hashIndex, 0, NULL)) {
+    case HASH_KEY_IS_STRING:
+      rc = php_cassandra_bind_argument_by_parameter(statement, prepared, hashKey,
+                                                    hashKeyLength - 1, *value TSRMLS_CC);
+      break;
+    case HASH_KEY_IS_LONG:
+      rc = php_cassandra_bind_argument_by_index(statement, hashIndex, *value TSRMLS_CC);
+      break;
+    default:
+      zend_throw_exception_ex(cassandra_runtime_exception_ce, 0 TSRMLS_CC,
+        "Unable to find name or index of the argument.");
+      return FAILURE;
+    }
+
+    if (rc == FAILURE)
+      break;
+
+    zend_hash_move_forward(arguments);
+  }
+
+  zend_hash_set_pointer(arguments, &ptr);
+
+  return rc;
+}
@@ -0,0 +1,15 @@
+#ifndef PHP_CASSANDRA_UTIL_BIND_H
+#define PHP_CASSANDRA_UTIL_BIND_H
+
+int php_cassandra_bind_argument_by_index(CassStatement* statement, size_t index, zval* value TSRMLS_DC);
+int php_cassandra_bind_argument_by_name(CassStatement* statement, const char* name,
+                                        size_t name_length, zval* value TSRMLS_DC);
+int php_cassandra_bind_argument_by_parameter(CassStatement* statement,
+                                             cassandra_prepared_statement* prepared,
+                                             const char* name, size_t name_length,
+                                             zval* value TSRMLS_DC);
+int php_cassandra_bind_arguments(CassStatement* statement,
+                                 cassandra_prepared_statement* prepared,
+                                 HashTable* arguments TSRMLS_DC);
+
+#endif /* PHP_CASSANDRA_UTIL_BIND_H */
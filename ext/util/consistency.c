@@ -42,3 +42,21 @@ int php_cassandra_get_serial_consistency(zval* serial_consistency, long* result
   }
   return SUCCESS;
 }
+
+const char* php_cassandra_consistency_string(long consistency)
+{
+  switch (consistency) {
+  case CASS_CONSISTENCY_ANY:          return "ANY";
+  case CASS_CONSISTENCY_ONE:          return "ONE";
+  case CASS_CONSISTENCY_TWO:          return "TWO";
+  case CASS_CONSISTENCY_THREE:        return "THREE";
+  case CASS_CONSISTENCY_QUORUM:       return "QUORUM";
+  case CASS_CONSISTENCY_ALL:          return "ALL";
+  case CASS_CONSISTENCY_LOCAL_QUORUM: return "LOCAL_QUORUM";
+  case CASS_CONSISTENCY_EACH_QUORUM:  return "EACH_QUORUM";
+  case CASS_CONSISTENCY_SERIAL:       return "SERIAL";
+  case CASS_CONSISTENCY_LOCAL_SERIAL: return "LOCAL_SERIAL";
+  case CASS_CONSISTENCY_LOCAL_ONE:    return "LOCAL_ONE";
+  default:                            return "UNKNOWN";
+  }
+}
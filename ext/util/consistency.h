@@ -3,5 +3,6 @@
 
 int php_cassandra_get_consistency(zval* consistency, long* result TSRMLS_DC);
 int php_cassandra_get_serial_consistency(zval* serial_consistency, long* result TSRMLS_DC);
+const char* php_cassandra_consistency_string(long consistency);
 
 #endif /* PHP_CASSANDRA_CONSISTENCY_H */
@@ -0,0 +1,113 @@
+#include "php_cassandra.h"
+#include "util/execution_info.h"
+
+ZEND_EXTERN_MODULE_GLOBALS(cassandra)
+
+cassandra_execution_info*
+php_cassandra_execution_info_new(TSRMLS_D)
+{
+  if (!CASSANDRA_G(execution_info) && CASSANDRA_G(slow_query_threshold_ms) <= 0)
+    return NULL;
+
+  return (cassandra_execution_info*) ecalloc(1, sizeof(cassandra_execution_info));
+}
+
+void
+php_cassandra_execution_info_context(cassandra_execution_info* info,
+                                     zval* statement, zval* arguments,
+                                     long consistency, long page_size TSRMLS_DC)
+{
+  if (!info || CASSANDRA_G(slow_query_threshold_ms) <= 0)
+    return;
+
+  Z_ADDREF_P(statement);
+  info->statement = statement;
+
+  if (arguments) {
+    Z_ADDREF_P(arguments);
+    info->arguments = arguments;
+  }
+
+  info->consistency = consistency;
+  info->page_size   = page_size;
+}
+
+void
+php_cassandra_execution_info_clear_context(cassandra_execution_info* info)
+{
+  if (info->statement) {
+    zval_ptr_dtor(&info->statement);
+    info->statement = NULL;
+  }
+
+  if (info->arguments) {
+    zval_ptr_dtor(&info->arguments);
+    info->arguments = NULL;
+  }
+}
+
+void
+php_cassandra_execution_info_free(cassandra_execution_info** info_ptr)
+{
+  if (*info_ptr) {
+    php_cassandra_execution_info_clear_context(*info_ptr);
+    efree(*info_ptr);
+    *info_ptr = NULL;
+  }
+}
+
+void
+php_cassandra_execution_info_result(cassandra_execution_info* info,
+                                    const CassResult* result, size_t size)
+{
+  if (!info)
+    return;
+
+  /* The size is counted by the decoder, so the result is not scanned again */
+  info->row_count   = cass_result_row_count(result);
+  info->result_size = size;
+}
+
+static double
+php_cassandra_elapsed(cass_uint64_t start, cass_uint64_t end)
+{
+  if (start == 0 || end < start)
+    return 0.0;
+
+  return (end - start) / 1000000000.0;
+}
+
+void
+php_cassandra_execution_info_to_array(cassandra_execution_info* info,
+                                      zval* out TSRMLS_DC)
+{
+  array_init(out);
+
+  add_assoc_long(out, "bind_start",  info->bind_start);
+  add_assoc_long(out, "bind_end",    info->bind_end);
+  add_assoc_long(out, "submit",      info->submit);
+  add_assoc_long(out, "response",    info->response);
+  add_assoc_long(out, "decode_end",  info->decode_end);
+  add_assoc_long(out, "result_size", info->result_size);
+  add_assoc_long(out, "row_count",   info->row_count);
+
+  add_assoc_double(out, "bind_time",   php_cassandra_elapsed(info->bind_start, info->bind_end));
+  add_assoc_double(out, "wait_time",   php_cassandra_elapsed(info->submit, info->response));
+  add_assoc_double(out, "decode_time", php_cassandra_elapsed(info->response, info->decode_end));
+}
+
+void
+php_cassandra_execution_info_attach(cassandra_execution_info* info TSRMLS_DC)
+{
+  zval* value;
+
+  if (!info || !EG(exception))
+    return;
+
+  MAKE_STD_ZVAL(value);
+  php_cassandra_execution_info_to_array(info, value TSRMLS_CC);
+  zend_update_property(Z_OBJCE_P(EG(exception)), EG(exception),
+                       "executionInfo", sizeof("executionInfo") - 1,
+                       value TSRMLS_CC);
+  zval_ptr_dtor(&value);
+}
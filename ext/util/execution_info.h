@@ -0,0 +1,23 @@
+#ifndef PHP_CASSANDRA_UTIL_EXECUTION_INFO_H
+#define PHP_CASSANDRA_UTIL_EXECUTION_INFO_H
+
+#include <uv.h>
+
+#define PHP_CASSANDRA_EXECUTION_INFO_MARK(info, field) \
+  do { \
+    if (info) (info)->field = uv_hrtime(); \
+  } while (0)
+
+cassandra_execution_info* php_cassandra_execution_info_new(TSRMLS_D);
+void php_cassandra_execution_info_context(cassandra_execution_info* info,
+                                          zval* statement, zval* arguments,
+                                          long consistency, long page_size TSRMLS_DC);
+void php_cassandra_execution_info_clear_context(cassandra_execution_info* info);
+void php_cassandra_execution_info_free(cassandra_execution_info** info_ptr);
+void php_cassandra_execution_info_result(cassandra_execution_info* info,
+                                         const CassResult* result, size_t size);
+void php_cassandra_execution_info_to_array(cassandra_execution_info* info,
+                                           zval* out TSRMLS_DC);
+void php_cassandra_execution_info_attach(cassandra_execution_info* info TSRMLS_DC);
+
+#endif /* PHP_CASSANDRA_UTIL_EXECUTION_INFO_H */
@@ -0,0 +1,72 @@
+#include "php_cassandra.h"
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+#include "util/fork.h"
+
+ZEND_EXTERN_MODULE_GLOBALS(cassandra)
+
+/* Prefork SAPIs (php-fpm, apache prefork) initialize the extension once in
+ * the master and fork workers from it. Everything that is plain memory, such
+ * as persistent clusters (CassCluster only holds configuration) and the
+ * statistics table, is inherited by the workers as is. What relies on
+ * threads (the IO threads of persistent sessions) or must be unique per
+ * process (the UUID generator) is reset in the child.
+ *
+ * No pthread_atfork() handler is used: it would also run in the short-lived
+ * children of proc_open(), popen() or shell_exec(), where allocating or
+ * taking locks that a driver thread may have held while forking can
+ * deadlock. A fork is instead noticed by the process id having changed, at
+ * the start of a request and before the state is used. The async log does
+ * the same for its writer thread. */
+
+#ifndef _WIN32
+static pid_t fork_pid = 0;
+
+static int
+php_cassandra_fork_orphan_session(void* data TSRMLS_DC)
+{
+  zend_rsrc_list_entry* le = (zend_rsrc_list_entry*) data;
+
+  if (Z_TYPE_P(le) != php_le_cassandra_session())
+    return ZEND_HASH_APPLY_KEEP;
+
+  /* The session can neither be used nor freed without the IO threads of the
+   * parent, so it is leaked and a new one gets connected on demand. */
+  if (le->ptr) {
+    le->ptr = NULL;
+    CASSANDRA_G(persistent_sessions)--;
+  }
+
+  return ZEND_HASH_APPLY_REMOVE;
+}
+#endif
+
+void
+php_cassandra_fork_startup()
+{
+#ifndef _WIN32
+  fork_pid = getpid();
+#endif
+}
+
+void
+php_cassandra_fork_check(TSRMLS_D)
+{
+#ifndef _WIN32
+  if (fork_pid == getpid())
+    return;
+
+  fork_pid = getpid();
+
+  /* The generator of the parent is not freed as its lock may have been held
+   * by another thread while forking. A new one gets a new clock sequence and
+   * random state, otherwise workers would generate the same UUIDs. */
+  CASSANDRA_G(uuid_gen) = cass_uuid_gen_new();
+
+  zend_hash_apply(&EG(persistent_list), php_cassandra_fork_orphan_session TSRMLS_CC);
+
+  /* Sessions declared in php.ini are connected again by the worker. */
+  CASSANDRA_G(sessions_prewarmed) = 0;
+#endif
+}
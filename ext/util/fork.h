@@ -0,0 +1,7 @@
+#ifndef PHP_CASSANDRA_UTIL_FORK_H
+#define PHP_CASSANDRA_UTIL_FORK_H
+
+void php_cassandra_fork_startup();
+void php_cassandra_fork_check(TSRMLS_D);
+
+#endif /* PHP_CASSANDRA_UTIL_FORK_H */
@@ -0,0 +1,175 @@
+#include "php_cassandra.h"
+#include "util/iterator.h"
+
+/* Positions kept outside of a hash table are not moved when their element
+ * is deleted, so they are checked against the table before each use, the
+ * same way SPL's ArrayIterator does. */
+static int
+php_cassandra_iterator_verify(php_cassandra_iterator* iterator TSRMLS_DC)
+{
+  Bucket* p;
+
+  if (!iterator->pos)
+    return FAILURE;
+
+  for (p = iterator->values->arBuckets[iterator->h & iterator->values->nTableMask]; p; p = p->pNext) {
+    if (p == iterator->pos)
+      return SUCCESS;
+  }
+
+  iterator->pos = NULL;
+  zend_error(E_NOTICE, "%s was modified during iteration, the iteration stops",
+             Z_OBJCE_P((zval*) iterator->it.data)->name);
+
+  return FAILURE;
+}
+
+static void
+php_cassandra_iterator_dtor(zend_object_iterator* it TSRMLS_DC)
+{
+  zval* object = (zval*) it->data;
+
+  zval_ptr_dtor(&object);
+  efree(it);
+}
+
+static int
+php_cassandra_iterator_valid(zend_object_iterator* it TSRMLS_DC)
+{
+  return php_cassandra_iterator_verify((php_cassandra_iterator*) it TSRMLS_CC);
+}
+
+static void
+php_cassandra_iterator_get_current_data(zend_object_iterator* it, zval*** data TSRMLS_DC)
+{
+  php_cassandra_iterator* iterator = (php_cassandra_iterator*) it;
+
+  if (php_cassandra_iterator_verify(iterator TSRMLS_CC) == FAILURE ||
+      zend_hash_get_current_data_ex(iterator->values, (void**) data, &iterator->pos) == FAILURE)
+    *data = NULL;
+}
+
+#if PHP_VERSION_ID >= 50500
+static void
+php_cassandra_iterator_get_current_key(zend_object_iterator* it, zval* key TSRMLS_DC)
+{
+  php_cassandra_iterator* iterator = (php_cassandra_iterator*) it;
+
+  if (php_cassandra_iterator_verify(iterator TSRMLS_CC) == SUCCESS)
+    iterator->key(iterator, key TSRMLS_CC);
+  else
+    ZVAL_NULL(key);
+}
+#else
+/* Keys other than integers and strings can't be returned before PHP 5.5,
+ * they are null instead. */
+static int
+php_cassandra_iterator_get_current_key(zend_object_iterator* it, char** str_key,
+                                       uint* str_key_len, ulong* int_key TSRMLS_DC)
+{
+  php_cassandra_iterator* iterator = (php_cassandra_iterator*) it;
+  int type = HASH_KEY_NON_EXISTANT;
+  zval key;
+
+  INIT_ZVAL(key);
+
+  if (php_cassandra_iterator_verify(iterator TSRMLS_CC) == SUCCESS)
+    iterator->key(iterator, &key TSRMLS_CC);
+
+  switch (Z_TYPE(key)) {
+    case IS_LONG:
+      *int_key = Z_LVAL(key);
+      type     = HASH_KEY_IS_LONG;
+      break;
+    case IS_STRING:
+      *str_key     = estrndup(Z_STRVAL(key), Z_STRLEN(key));
+      *str_key_len = Z_STRLEN(key) + 1;
+      type         = HASH_KEY_IS_STRING;
+      break;
+  }
+
+  zval_dtor(&key);
+
+  return type;
+}
+#endif
+
+static void
+php_cassandra_iterator_move_forward(zend_object_iterator* it TSRMLS_DC)
+{
+  php_cassandra_iterator* iterator = (php_cassandra_iterator*) it;
+
+  if (php_cassandra_iterator_verify(iterator TSRMLS_CC) == FAILURE)
+    return;
+
+  zend_hash_move_forward_ex(iterator->values, &iterator->pos);
+  iterator->h = iterator->pos ? iterator->pos->h : 0;
+  iterator->index++;
+}
+
+static void
+php_cassandra_iterator_rewind(zend_object_iterator* it TSRMLS_DC)
+{
+  php_cassandra_iterator* iterator = (php_cassandra_iterator*) it;
+
+  zend_hash_internal_pointer_reset_ex(iterator->values, &iterator->pos);
+  iterator->h     = iterator->pos ? iterator->pos->h : 0;
+  iterator->index = 0;
+}
+
+static zend_object_iterator_funcs php_cassandra_iterator_funcs = {
+  php_cassandra_iterator_dtor,
+  php_cassandra_iterator_valid,
+  php_cassandra_iterator_get_current_data,
+  php_cassandra_iterator_get_current_key,
+  php_cassandra_iterator_move_forward,
+  php_cassandra_iterator_rewind,
+  NULL
+};
+
+zend_object_iterator*
+php_cassandra_iterator_new(zval* object, HashTable* values,
+                           php_cassandra_iterator_key_function key,
+                           int by_ref TSRMLS_DC)
+{
+  php_cassandra_iterator* iterator;
+
+  if (by_ref) {
+    zend_throw_exception_ex(cassandra_logic_exception_ce, 0 TSRMLS_CC,
+                            "%s cannot be iterated by reference",
+                            Z_OBJCE_P(object)->name);
+    return NULL;
+  }
+
+  iterator = (php_cassandra_iterator*) ecalloc(1, sizeof(php_cassandra_iterator));
+
+  Z_ADDREF_P(object);
+  iterator->it.data  = object;
+  iterator->it.funcs = &php_cassandra_iterator_funcs;
+  iterator->values   = values;
+  iterator->key      = key;
+
+  php_cassandra_iterator_rewind(&iterator->it TSRMLS_CC);
+
+  return &iterator->it;
+}
+
+/* Keys are the positions of the values, as in a list */
+void
+php_cassandra_iterator_key_index(php_cassandra_iterator* iterator, zval* key TSRMLS_DC)
+{
+  ZVAL_LONG(key, iterator->index);
+}
+
+/* Keys are the integer keys of the hash table */
+void
+php_cassandra_iterator_key_hash(php_cassandra_iterator* iterator, zval* key TSRMLS_DC)
+{
+  ulong index;
+
+  if (zend_hash_get_current_key_ex(iterator->values, NULL, NULL, &index, 0,
+                                   &iterator->pos) == HASH_KEY_IS_LONG)
+    ZVAL_LONG(key, index);
+  else
+    ZVAL_NULL(key);
+}
@@ -0,0 +1,27 @@
+#ifndef PHP_CASSANDRA_UTIL_ITERATOR_H
+#define PHP_CASSANDRA_UTIL_ITERATOR_H
+
+typedef struct php_cassandra_iterator_ php_cassandra_iterator;
+
+typedef void (*php_cassandra_iterator_key_function)(php_cassandra_iterator* iterator,
+                                                     zval* key TSRMLS_DC);
+
+/* An iterator over the values of an object's hash table with a position of
+ * its own, so that iterations don't share the table's internal pointer. */
+struct php_cassandra_iterator_ {
+  zend_object_iterator it;
+  HashTable* values;
+  HashPosition pos;
+  ulong h;
+  long index;
+  php_cassandra_iterator_key_function key;
+};
+
+zend_object_iterator* php_cassandra_iterator_new(zval* object, HashTable* values,
+                                                 php_cassandra_iterator_key_function key,
+                                                 int by_ref TSRMLS_DC);
+
+void php_cassandra_iterator_key_index(php_cassandra_iterator* iterator, zval* key TSRMLS_DC);
+void php_cassandra_iterator_key_hash(php_cassandra_iterator* iterator, zval* key TSRMLS_DC);
+
+#endif /* PHP_CASSANDRA_UTIL_ITERATOR_H */
@@ -0,0 +1,344 @@
+#include "php_cassandra.h"
+#include <ext/standard/info.h>
+#include <ext/standard/php_smart_str.h>
+#include "util/metrics.h"
+#include "util/stats.h"
+
+#define PHP_CASSANDRA_METRICS_MAX_SESSIONS 16
+
+ZEND_EXTERN_MODULE_GLOBALS(cassandra)
+
+/* Falls back to counting per process when the shared statistics table is
+ * not allocated. */
+static cassandra_counters local_counters;
+
+cassandra_counters*
+php_cassandra_counters()
+{
+  cassandra_counters* counters = php_cassandra_stats_counters();
+  return counters ? counters : &local_counters;
+}
+
+void
+php_cassandra_get_metrics(CassSession* session, zval* out TSRMLS_DC)
+{
+  CassMetrics metrics;
+  zval* requests;
+  zval* stats;
+  zval* errors;
+#if CURRENT_CPP_DRIVER_VERSION >= CPP_DRIVER_VERSION(2, 10, 0)
+  CassSpeculativeExecutionMetrics speculative_metrics;
+  zval* speculative;
+#endif
+
+  cass_session_get_metrics(session, &metrics);
+
+  MAKE_STD_ZVAL(requests);
+  array_init(requests);
+  add_assoc_long(requests, "min",                 metrics.requests.min);
+  add_assoc_long(requests, "max",                 metrics.requests.max);
+  add_assoc_long(requests, "mean",                metrics.requests.mean);
+  add_assoc_long(requests, "stddev",              metrics.requests.stddev);
+  add_assoc_long(requests, "median",              metrics.requests.median);
+  add_assoc_long(requests, "percentile_75th",     metrics.requests.percentile_75th);
+  add_assoc_long(requests, "percentile_95th",     metrics.requests.percentile_95th);
+  add_assoc_long(requests, "percentile_98th",     metrics.requests.percentile_98th);
+  add_assoc_long(requests, "percentile_99th",     metrics.requests.percentile_99th);
+  add_assoc_long(requests, "percentile_999th",    metrics.requests.percentile_999th);
+  add_assoc_double(requests, "mean_rate",           metrics.requests.mean_rate);
+  add_assoc_double(requests, "one_minute_rate",     metrics.requests.one_minute_rate);
+  add_assoc_double(requests, "five_minute_rate",    metrics.requests.five_minute_rate);
+  add_assoc_double(requests, "fifteen_minute_rate", metrics.requests.fifteen_minute_rate);
+
+  MAKE_STD_ZVAL(stats);
+  array_init(stats);
+  add_assoc_long(stats, "total_connections",
+                 metrics.stats.total_connections);
+  add_assoc_long(stats, "available_connections",
+                 metrics.stats.available_connections);
+  add_assoc_long(stats, "exceeded_pending_requests_water_mark",
+                 metrics.stats.exceeded_pending_requests_water_mark);
+  add_assoc_long(stats, "exceeded_write_bytes_water_mark",
+                 metrics.stats.exceeded_write_bytes_water_mark);
+
+  MAKE_STD_ZVAL(errors);
+  array_init(errors);
+  add_assoc_long(errors, "connection_timeouts",
+                 metrics.errors.connection_timeouts);
+  add_assoc_long(errors, "pending_request_timeouts",
+                 metrics.errors.pending_request_timeouts);
+  add_assoc_long(errors, "request_timeouts",
+                 metrics.errors.request_timeouts);
+
+  array_init(out);
+  add_assoc_zval(out, "requests", requests);
+  add_assoc_zval(out, "stats",    stats);
+  add_assoc_zval(out, "errors",   errors);
+
+#if CURRENT_CPP_DRIVER_VERSION >= CPP_DRIVER_VERSION(2, 10, 0)
+  /* The driver counts speculative executions that were aborted because
+   * another execution of the same request answered first. */
+  cass_session_get_speculative_execution_metrics(session, &speculative_metrics);
+
+  MAKE_STD_ZVAL(speculative);
+  array_init(speculative);
+  add_assoc_long(speculative, "aborted",          speculative_metrics.count);
+  add_assoc_double(speculative, "aborted_rate",   speculative_metrics.percentage);
+  add_assoc_long(speculative, "min",              speculative_metrics.min);
+  add_assoc_long(speculative, "max",              speculative_metrics.max);
+  add_assoc_long(speculative, "mean",             speculative_metrics.mean);
+  add_assoc_long(speculative, "median",           speculative_metrics.median);
+  add_assoc_long(speculative, "percentile_99th",  speculative_metrics.percentile_99th);
+
+  add_assoc_zval(out, "speculative_executions", speculative);
+#endif
+}
+
+#define PRINT_METRIC(name, format, value) \
+  snprintf(buf, sizeof(buf), format, value); \
+  php_info_print_table_row(2, name, buf);
+
+void
+php_cassandra_print_metrics(CassSession* session, const char* title)
+{
+  char buf[256];
+  CassMetrics metrics;
+#if CURRENT_CPP_DRIVER_VERSION >= CPP_DRIVER_VERSION(2, 10, 0)
+  CassSpeculativeExecutionMetrics speculative;
+
+  cass_session_get_speculative_execution_metrics(session, &speculative);
+#endif
+
+  cass_session_get_metrics(session, &metrics);
+
+  php_info_print_table_start();
+  php_info_print_table_header(2, title, "Value");
+
+  PRINT_METRIC("Request latency min (us)",    "%llu", (unsigned long long) metrics.requests.min);
+  PRINT_METRIC("Request latency max (us)",    "%llu", (unsigned long long) metrics.requests.max);
+  PRINT_METRIC("Request latency mean (us)",   "%llu", (unsigned long long) metrics.requests.mean);
+  PRINT_METRIC("Request latency median (us)", "%llu", (unsigned long long) metrics.requests.median);
+  PRINT_METRIC("Request latency p75 (us)",    "%llu", (unsigned long long) metrics.requests.percentile_75th);
+  PRINT_METRIC("Request latency p95 (us)",    "%llu", (unsigned long long) metrics.requests.percentile_95th);
+  PRINT_METRIC("Request latency p98 (us)",    "%llu", (unsigned long long) metrics.requests.percentile_98th);
+  PRINT_METRIC("Request latency p99 (us)",    "%llu", (unsigned long long) metrics.requests.percentile_99th);
+  PRINT_METRIC("Request latency p99.9 (us)",  "%llu", (unsigned long long) metrics.requests.percentile_999th);
+  PRINT_METRIC("Request rate mean (req/s)",   "%.2f", metrics.requests.mean_rate);
+  PRINT_METRIC("Request rate 1m (req/s)",     "%.2f", metrics.requests.one_minute_rate);
+  PRINT_METRIC("Request rate 5m (req/s)",     "%.2f", metrics.requests.five_minute_rate);
+  PRINT_METRIC("Request rate 15m (req/s)",    "%.2f", metrics.requests.fifteen_minute_rate);
+  PRINT_METRIC("Total connections",           "%llu", (unsigned long long) metrics.stats.total_connections);
+  PRINT_METRIC("Available connections",       "%llu", (unsigned long long) metrics.stats.available_connections);
+  PRINT_METRIC("Connection timeouts",         "%llu", (unsigned long long) metrics.errors.connection_timeouts);
+  PRINT_METRIC("Pending request timeouts",    "%llu", (unsigned long long) metrics.errors.pending_request_timeouts);
+  PRINT_METRIC("Request timeouts",            "%llu", (unsigned long long) metrics.errors.request_timeouts);
+#if CURRENT_CPP_DRIVER_VERSION >= CPP_DRIVER_VERSION(2, 10, 0)
+  PRINT_METRIC("Aborted speculative executions", "%llu", (unsigned long long) speculative.count);
+  PRINT_METRIC("Aborted speculative rate (%)",   "%.2f", speculative.percentage);
+#endif
+
+  php_info_print_table_end();
+}
+
+#undef PRINT_METRIC
+
+static void
+php_cassandra_metrics_header(smart_str* out, const char* name,
+                             const char* type, const char* help)
+{
+  smart_str_appends(out, "# TYPE ");
+  smart_str_appends(out, name);
+  smart_str_appendc(out, ' ');
+  smart_str_appends(out, type);
+  smart_str_appends(out, "\n# HELP ");
+  smart_str_appends(out, name);
+  smart_str_appendc(out, ' ');
+  smart_str_appends(out, help);
+  smart_str_appendc(out, '\n');
+}
+
+static void
+php_cassandra_metrics_sample(smart_str* out, const char* name,
+                             const char* labels, double value)
+{
+  char buf[64];
+
+  smart_str_appends(out, name);
+  if (labels && *labels) {
+    smart_str_appendc(out, '{');
+    smart_str_appends(out, labels);
+    smart_str_appendc(out, '}');
+  }
+  snprintf(buf, sizeof(buf), " %.17g\n", value);
+  smart_str_appends(out, buf);
+}
+
+static void
+php_cassandra_metrics_label_value(char* out, size_t size, const char* value)
+{
+  size_t i = 0;
+
+  for (; *value && i + 2 < size; value++) {
+    if (*value == '\\' || *value == '"') {
+      out[i++] = '\\';
+      out[i++] = *value;
+    } else if (*value == '\n') {
+      out[i++] = '\\';
+      out[i++] = 'n';
+    } else {
+      out[i++] = *value;
+    }
+  }
+
+  out[i] = '\0';
+}
+
+static void
+php_cassandra_export_counters(smart_str* out TSRMLS_DC)
+{
+  cassandra_counters* counters = php_cassandra_counters();
+
+  php_cassandra_metrics_header(out, "cassandra_persistent_clusters", "gauge",
+                               "Persistent clusters held by this process.");
+  php_cassandra_metrics_sample(out, "cassandra_persistent_clusters", NULL,
+                               CASSANDRA_G(persistent_clusters));
+
+  php_cassandra_metrics_header(out, "cassandra_persistent_sessions", "gauge",
+                               "Persistent sessions held by this process.");
+  php_cassandra_metrics_sample(out, "cassandra_persistent_sessions", NULL,
+                               CASSANDRA_G(persistent_sessions));
+
+  php_cassandra_metrics_header(out, "cassandra_requests", "counter",
+                               "Requests submitted to the driver.");
+  php_cassandra_metrics_sample(out, "cassandra_requests_total", NULL,
+                               counters->requests);
+
+  php_cassandra_metrics_header(out, "cassandra_request_errors", "counter",
+                               "Requests that completed with an error.");
+  php_cassandra_metrics_sample(out, "cassandra_request_errors_total", NULL,
+                               counters->request_errors);
+
+  php_cassandra_metrics_header(out, "cassandra_binding_errors", "counter",
+                               "Statements that could not be bound.");
+  php_cassandra_metrics_sample(out, "cassandra_binding_errors_total", NULL,
+                               counters->binding_errors);
+
+  php_cassandra_metrics_header(out, "cassandra_prepared_statements", "counter",
+                               "Statements prepared.");
+  php_cassandra_metrics_sample(out, "cassandra_prepared_statements_total", NULL,
+                               counters->prepared_statements);
+
+  php_cassandra_metrics_header(out, "cassandra_decoded_rows", "counter",
+                               "Result rows decoded.");
+  php_cassandra_metrics_sample(out, "cassandra_decoded_rows_total", NULL,
+                               counters->decoded_rows);
+
+  php_cassandra_metrics_header(out, "cassandra_decoded_bytes", "counter",
+                               "Result value bytes decoded.");
+  php_cassandra_metrics_sample(out, "cassandra_decoded_bytes_total", NULL,
+                               counters->decoded_bytes);
+
+  php_cassandra_metrics_header(out, "cassandra_decode_seconds", "counter",
+                               "Time spent decoding results.");
+  php_cassandra_metrics_sample(out, "cassandra_decode_seconds_total", NULL,
+                               counters->decode_time / 1000000000.0);
+}
+
+typedef struct {
+  char        labels[192];
+  CassMetrics metrics;
+} php_cassandra_session_sample;
+
+/* Samples of a metric family must be contiguous, so each family is emitted
+ * once with a sample for every session. */
+#define EXPORT_SESSION_FAMILY_BEGIN(name, type, help) \
+  php_cassandra_metrics_header(out, name, type, help);
+
+#define EXPORT_SESSION_SAMPLES(name, extra, field) \
+  for (i = 0; i < count; i++) { \
+    snprintf(labels, sizeof(labels), "%s%s", samples[i].labels, extra); \
+    php_cassandra_metrics_sample(out, name, labels, samples[i].metrics.field); \
+  }
+
+static void
+php_cassandra_export_sessions(smart_str* out,
+                              php_cassandra_session_sample* samples, int count)
+{
+  char labels[256];
+  int i;
+
+  EXPORT_SESSION_FAMILY_BEGIN("cassandra_session_request_latency_microseconds", "summary",
+                              "Driver request latency.")
+  EXPORT_SESSION_SAMPLES("cassandra_session_request_latency_microseconds", ",quantile=\"0.5\"",   requests.median)
+  EXPORT_SESSION_SAMPLES("cassandra_session_request_latency_microseconds", ",quantile=\"0.75\"",  requests.percentile_75th)
+  EXPORT_SESSION_SAMPLES("cassandra_session_request_latency_microseconds", ",quantile=\"0.95\"",  requests.percentile_95th)
+  EXPORT_SESSION_SAMPLES("cassandra_session_request_latency_microseconds", ",quantile=\"0.98\"",  requests.percentile_98th)
+  EXPORT_SESSION_SAMPLES("cassandra_session_request_latency_microseconds", ",quantile=\"0.99\"",  requests.percentile_99th)
+  EXPORT_SESSION_SAMPLES("cassandra_session_request_latency_microseconds", ",quantile=\"0.999\"", requests.percentile_999th)
+
+  EXPORT_SESSION_FAMILY_BEGIN("cassandra_session_request_rate", "gauge",
+                              "Driver request rate in requests per second.")
+  EXPORT_SESSION_SAMPLES("cassandra_session_request_rate", ",window=\"mean\"", requests.mean_rate)
+  EXPORT_SESSION_SAMPLES("cassandra_session_request_rate", ",window=\"1m\"",   requests.one_minute_rate)
+  EXPORT_SESSION_SAMPLES("cassandra_session_request_rate", ",window=\"5m\"",   requests.five_minute_rate)
+  EXPORT_SESSION_SAMPLES("cassandra_session_request_rate", ",window=\"15m\"",  requests.fifteen_minute_rate)
+
+  EXPORT_SESSION_FAMILY_BEGIN("cassandra_session_connections", "gauge",
+                              "Driver connections.")
+  EXPORT_SESSION_SAMPLES("cassandra_session_connections", ",state=\"total\"",     stats.total_connections)
+  EXPORT_SESSION_SAMPLES("cassandra_session_connections", ",state=\"available\"", stats.available_connections)
+
+  EXPORT_SESSION_FAMILY_BEGIN("cassandra_session_water_marks_exceeded", "counter",
+                              "Times a connection exceeded a water mark.")
+  EXPORT_SESSION_SAMPLES("cassandra_session_water_marks_exceeded_total", ",kind=\"pending_requests\"", stats.exceeded_pending_requests_water_mark)
+  EXPORT_SESSION_SAMPLES("cassandra_session_water_marks_exceeded_total", ",kind=\"write_bytes\"",      stats.exceeded_write_bytes_water_mark)
+
+  EXPORT_SESSION_FAMILY_BEGIN("cassandra_session_timeouts", "counter",
+                              "Driver timeouts.")
+  EXPORT_SESSION_SAMPLES("cassandra_session_timeouts_total", ",kind=\"connection\"",      errors.connection_timeouts)
+  EXPORT_SESSION_SAMPLES("cassandra_session_timeouts_total", ",kind=\"pending_request\"", errors.pending_request_timeouts)
+  EXPORT_SESSION_SAMPLES("cassandra_session_timeouts_total", ",kind=\"request\"",         errors.request_timeouts)
+}
+
+#undef EXPORT_SESSION_FAMILY_BEGIN
+#undef EXPORT_SESSION_SAMPLES
+
+void
+php_cassandra_export_metrics(zval* out TSRMLS_DC)
+{
+  smart_str text = { NULL, 0, 0 };
+  php_cassandra_session_sample samples[PHP_CASSANDRA_METRICS_MAX_SESSIONS];
+  HashPosition pos;
+  zend_rsrc_list_entry* le;
+  int count = 0;
+
+  php_cassandra_export_counters(&text TSRMLS_CC);
+
+  /* Sessions are capped to keep label cardinality bounded */
+  zend_hash_internal_pointer_reset_ex(&EG(persistent_list), &pos);
+  while (count < PHP_CASSANDRA_METRICS_MAX_SESSIONS &&
+         zend_hash_get_current_data_ex(&EG(persistent_list), (void**) &le, &pos) == SUCCESS) {
+    if (le->type == php_le_cassandra_session()) {
+      cassandra_psession* psession = (cassandra_psession*) le->ptr;
+      /* Only the keyspace is exported, the persistent key contains credentials */
+      char escaped[128];
+
+      php_cassandra_metrics_label_value(escaped, sizeof(escaped), SAFE_STR(psession->keyspace));
+      snprintf(samples[count].labels, sizeof(samples[count].labels),
+               "session=\"%d\",keyspace=\"%s\"", count, escaped);
+      cass_session_get_metrics(psession->session, &samples[count].metrics);
+      count++;
+    }
+
+    zend_hash_move_forward_ex(&EG(persistent_list), &pos);
+  }
+
+  if (count > 0)
+    php_cassandra_export_sessions(&text, samples, count);
+
+  smart_str_appends(&text, "# EOF\n");
+  smart_str_0(&text);
+
+  ZVAL_STRINGL(out, text.c, text.len, 1);
+  smart_str_free(&text);
+}
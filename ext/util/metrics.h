@@ -0,0 +1,15 @@
+#ifndef PHP_CASSANDRA_UTIL_METRICS_H
+#define PHP_CASSANDRA_UTIL_METRICS_H
+
+#include "util/atomic.h"
+
+#define PHP_CASSANDRA_COUNTER_ADD(name, value) \
+  PHP_CASSANDRA_ATOMIC_ADD(&php_cassandra_counters()->name, (value))
+
+cassandra_counters* php_cassandra_counters();
+
+void php_cassandra_get_metrics(CassSession* session, zval* out TSRMLS_DC);
+void php_cassandra_print_metrics(CassSession* session, const char* title);
+void php_cassandra_export_metrics(zval* out TSRMLS_DC);
+
+#endif /* PHP_CASSANDRA_UTIL_METRICS_H */
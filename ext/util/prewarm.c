@@ -0,0 +1,326 @@
+#include "php_cassandra.h"
+#include <ctype.h>
+#include "util/fork.h"
+#include "util/prewarm.h"
+#include "util/psession.h"
+
+#define PHP_CASSANDRA_PREWARM_KEY         "cassandra:prewarm:%s"
+#define PHP_CASSANDRA_PREWARM_CLUSTER_KEY "cassandra:prewarm:%s:cluster"
+
+ZEND_EXTERN_MODULE_GLOBALS(cassandra)
+
+/* A single entry of the `cassandra.sessions` ini setting:
+ *
+ *   name=contact_points[/keyspace][?option=value&option=value...]
+ *
+ * Entries are separated by semicolons.
+ */
+typedef struct {
+  char* name;
+  char* contact_points;
+  char* keyspace;
+  char* options;
+} cassandra_prewarm_declaration;
+
+static char*
+php_cassandra_prewarm_trim(char* value)
+{
+  char* end;
+
+  while (isspace((unsigned char) *value))
+    value++;
+
+  end = value + strlen(value);
+  while (end > value && isspace((unsigned char) end[-1]))
+    end--;
+  *end = '\0';
+
+  return value;
+}
+
+static int
+php_cassandra_prewarm_next(char** cursor, cassandra_prewarm_declaration* declaration)
+{
+  while (*cursor) {
+    char* entry = *cursor;
+    char* end   = strchr(entry, ';');
+    char* value;
+
+    if (end) {
+      *end = '\0';
+      *cursor = end + 1;
+    } else {
+      *cursor = NULL;
+    }
+
+    entry = php_cassandra_prewarm_trim(entry);
+    if (*entry == '\0')
+      continue;
+
+    memset(declaration, 0, sizeof(cassandra_prewarm_declaration));
+
+    value = strchr(entry, '=');
+    if (!value) {
+      declaration->name = entry;
+      return 1;
+    }
+
+    *value++ = '\0';
+    declaration->name = php_cassandra_prewarm_trim(entry);
+
+    declaration->options = strchr(value, '?');
+    if (declaration->options)
+      *declaration->options++ = '\0';
+
+    declaration->keyspace = strchr(value, '/');
+    if (declaration->keyspace) {
+      *declaration->keyspace++ = '\0';
+      declaration->keyspace = php_cassandra_prewarm_trim(declaration->keyspace);
+      if (*declaration->keyspace == '\0')
+        declaration->keyspace = NULL;
+    }
+
+    declaration->contact_points = php_cassandra_prewarm_trim(value);
+    return 1;
+  }
+
+  return 0;
+}
+
+static CassCluster*
+php_cassandra_prewarm_cluster(cassandra_prewarm_declaration* declaration, char** error)
+{
+  CassCluster* cluster = cass_cluster_new();
+  CassError rc         = CASS_OK;
+  char* option         = declaration->options;
+  char* username       = NULL;
+  char* password       = NULL;
+
+  /* Same defaults as Cassandra\Cluster\Builder */
+  cass_cluster_set_token_aware_routing(cluster, cass_true);
+  cass_cluster_set_latency_aware_routing(cluster, cass_true);
+  cass_cluster_set_tcp_nodelay(cluster, cass_true);
+  cass_cluster_set_connect_timeout(cluster, 5000);
+  cass_cluster_set_request_timeout(cluster, 12000);
+  cass_cluster_set_reconnect_wait_time(cluster, 2000);
+  cass_cluster_set_protocol_version(cluster, 2);
+  cass_cluster_set_num_threads_io(cluster, 1);
+  cass_cluster_set_core_connections_per_host(cluster, 1);
+  cass_cluster_set_max_connections_per_host(cluster, 2);
+
+  rc = cass_cluster_set_contact_points(cluster, declaration->contact_points);
+
+  while (rc == CASS_OK && option) {
+    char* next  = strchr(option, '&');
+    char* value = NULL;
+    long number = 0;
+
+    if (next)
+      *next++ = '\0';
+
+    value = strchr(option, '=');
+    if (!value) {
+      spprintf(error, 0, "Invalid option '%s' for session '%s'",
+               option, declaration->name);
+      break;
+    }
+
+    *value++ = '\0';
+    number = strtol(value, NULL, 10);
+
+    if (!strcmp(option, "port")) {
+      rc = cass_cluster_set_port(cluster, number);
+    } else if (!strcmp(option, "username")) {
+      username = value;
+    } else if (!strcmp(option, "password")) {
+      password = value;
+    } else if (!strcmp(option, "local_dc")) {
+      rc = cass_cluster_set_load_balance_dc_aware(cluster, value, 0, cass_false);
+    } else if (!strcmp(option, "protocol_version")) {
+      rc = cass_cluster_set_protocol_version(cluster, number);
+    } else if (!strcmp(option, "io_threads")) {
+      rc = cass_cluster_set_num_threads_io(cluster, number);
+    } else if (!strcmp(option, "core_connections")) {
+      rc = cass_cluster_set_core_connections_per_host(cluster, number);
+    } else if (!strcmp(option, "max_connections")) {
+      rc = cass_cluster_set_max_connections_per_host(cluster, number);
+    } else if (!strcmp(option, "connect_timeout_ms")) {
+      cass_cluster_set_connect_timeout(cluster, number);
+    } else if (!strcmp(option, "request_timeout_ms")) {
+      cass_cluster_set_request_timeout(cluster, number);
+    } else if (!strcmp(option, "token_aware")) {
+      cass_cluster_set_token_aware_routing(cluster, number ? cass_true : cass_false);
+    } else {
+      spprintf(error, 0, "Unknown option '%s' for session '%s'",
+               option, declaration->name);
+      break;
+    }
+
+    option = next;
+  }
+
+  if (rc != CASS_OK) {
+    spprintf(error, 0, "Unable to configure session '%s': %s",
+             declaration->name, cass_error_desc(rc));
+  }
+
+  if (*error) {
+    cass_cluster_free(cluster);
+    return NULL;
+  }
+
+  if (username)
+    cass_cluster_set_credentials(cluster, username, SAFE_STR(password));
+
+  return cluster;
+}
+
+static int
+php_cassandra_prewarm_connect(cassandra_prewarm_declaration* declaration, char** error TSRMLS_DC)
+{
+  char* hash_key;
+  int   hash_key_len;
+  char* cluster_key;
+  int   cluster_key_len;
+  zend_rsrc_list_entry le;
+  zend_rsrc_list_entry* existing;
+  CassCluster* cluster = NULL;
+
+  if (!declaration->contact_points || *declaration->name == '\0') {
+    spprintf(error, 0,
+             "Invalid session declaration '%s', expected "
+             "name=contact_points[/keyspace][?options]", declaration->name);
+    return FAILURE;
+  }
+
+  hash_key_len = spprintf(&hash_key, 0, PHP_CASSANDRA_PREWARM_KEY, declaration->name);
+
+  if (zend_hash_find(&EG(persistent_list), hash_key, hash_key_len + 1, (void**) &existing) == SUCCESS) {
+    efree(hash_key);
+    return SUCCESS;
+  }
+
+  /* The cluster is kept so that the session can be rebuilt, it stays in
+   * place when the session gets evicted. */
+  cluster_key_len = spprintf(&cluster_key, 0, PHP_CASSANDRA_PREWARM_CLUSTER_KEY, declaration->name);
+
+  if (zend_hash_find(&EG(persistent_list), cluster_key, cluster_key_len + 1, (void**) &existing) == SUCCESS &&
+      Z_TYPE_P(existing) == php_le_cassandra_cluster()) {
+    cluster = (CassCluster*) existing->ptr;
+  } else {
+    cluster = php_cassandra_prewarm_cluster(declaration, error);
+
+    if (!cluster) {
+      efree(cluster_key);
+      efree(hash_key);
+      return FAILURE;
+    }
+
+    le.type = php_le_cassandra_cluster();
+    le.ptr  = cluster;
+
+    zend_hash_update(&EG(persistent_list), cluster_key, cluster_key_len + 1, &le, sizeof(zend_rsrc_list_entry), NULL);
+    CASSANDRA_G(persistent_clusters)++;
+  }
+
+  le.type = php_le_cassandra_session();
+  le.ptr  = php_cassandra_psession_new(cluster, declaration->keyspace);
+
+  zend_hash_update(&EG(persistent_list), hash_key, hash_key_len + 1, &le, sizeof(zend_rsrc_list_entry), NULL);
+  CASSANDRA_G(persistent_sessions)++;
+
+  efree(cluster_key);
+  efree(hash_key);
+  return SUCCESS;
+}
+
+void
+php_cassandra_prewarm_startup(TSRMLS_D)
+{
+  cassandra_prewarm_declaration declaration;
+  char* sessions;
+  char* cursor;
+
+  if (!CASSANDRA_G(sessions) || *CASSANDRA_G(sessions) == '\0')
+    return;
+
+  sessions = cursor = estrdup(CASSANDRA_G(sessions));
+
+  /* Connections are only started here, nothing waits for them to complete */
+  while (php_cassandra_prewarm_next(&cursor, &declaration)) {
+    char* error = NULL;
+
+    if (php_cassandra_prewarm_connect(&declaration, &error TSRMLS_CC) == FAILURE) {
+      php_cassandra_log_line("ERROR", error);
+      efree(error);
+    }
+  }
+
+  efree(sessions);
+}
+
+static cassandra_psession*
+php_cassandra_prewarm_find(const char* name, int name_len TSRMLS_DC)
+{
+  char* hash_key;
+  int   hash_key_len;
+  zend_rsrc_list_entry* le;
+  cassandra_psession* psession = NULL;
+
+  hash_key_len = spprintf(&hash_key, 0, PHP_CASSANDRA_PREWARM_KEY, name);
+
+  if (zend_hash_find(&EG(persistent_list), hash_key, hash_key_len + 1, (void**) &le) == SUCCESS &&
+      Z_TYPE_P(le) == php_le_cassandra_session()) {
+    psession = (cassandra_psession*) le->ptr;
+  }
+
+  efree(hash_key);
+  return psession;
+}
+
+cassandra_psession*
+php_cassandra_prewarm_session(const char* name, int name_len TSRMLS_DC)
+{
+  cassandra_prewarm_declaration declaration;
+  cassandra_psession* psession;
+  char* sessions;
+  char* cursor;
+  char* error = NULL;
+  int found   = 0;
+
+  php_cassandra_fork_check(TSRMLS_C);
+
+  psession = php_cassandra_prewarm_find(name, name_len TSRMLS_CC);
+  if (psession) {
+    php_cassandra_psession_touch(psession);
+    return php_cassandra_psession_check(psession TSRMLS_CC) == SUCCESS ? psession : NULL;
+  }
+
+  /* Not connected yet in this process or evicted */
+  sessions = cursor = estrdup(SAFE_STR(CASSANDRA_G(sessions)));
+
+  while (!found && php_cassandra_prewarm_next(&cursor, &declaration)) {
+    if (strcmp(declaration.name, name) == 0) {
+      found = 1;
+      php_cassandra_prewarm_connect(&declaration, &error TSRMLS_CC);
+    }
+  }
+
+  efree(sessions);
+
+  if (!found) {
+    zend_throw_exception_ex(cassandra_invalid_argument_exception_ce, 0 TSRMLS_CC,
+                            "Unknown session '%s', sessions must be declared "
+                            "using the cassandra.sessions ini setting", name);
+    return NULL;
+  }
+
+  if (error) {
+    zend_throw_exception_ex(cassandra_invalid_argument_exception_ce, 0 TSRMLS_CC,
+                            "%s", error);
+    efree(error);
+    return NULL;
+  }
+
+  return php_cassandra_prewarm_find(name, name_len TSRMLS_CC);
+}
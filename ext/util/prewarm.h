@@ -0,0 +1,7 @@
+#ifndef PHP_CASSANDRA_UTIL_PREWARM_H
+#define PHP_CASSANDRA_UTIL_PREWARM_H
+
+void php_cassandra_prewarm_startup(TSRMLS_D);
+cassandra_psession* php_cassandra_prewarm_session(const char* name, int name_len TSRMLS_DC);
+
+#endif /* PHP_CASSANDRA_UTIL_PREWARM_H */
@@ -0,0 +1,222 @@
+#include "php_cassandra.h"
+#include <uv.h>
+#include "util/psession.h"
+
+ZEND_EXTERN_MODULE_GLOBALS(cassandra)
+
+/* Persistent sessions are kept per cluster and keyspace.
+ *
+ * Sessions that failed to connect or lost all of their connections are
+ * rebuilt at the end of the request, once nothing refers to them anymore.
+ * Until the new session is connected, requests fail immediately with the
+ * last error instead of waiting for their timeout.
+ *
+ * Freeing a session waits for its connections and threads to be closed, so
+ * a rebuild only starts closing the old session and connecting the new one.
+ * The old session is freed at the end of a later request, once it is
+ * closed. */
+
+/* Interval between two checks of the connections of a healthy session */
+#define PHP_CASSANDRA_PSESSION_CHECK_INTERVAL 1000000000ULL
+
+static unsigned long psession_clock = 0;
+
+static void
+php_cassandra_psession_connect(cassandra_psession* psession)
+{
+  psession->session = cass_session_new();
+
+  if (psession->keyspace) {
+    psession->future = cass_session_connect_keyspace(psession->session, psession->cluster,
+                                                     psession->keyspace);
+  } else {
+    psession->future = cass_session_connect(psession->session, psession->cluster);
+  }
+}
+
+cassandra_psession*
+php_cassandra_psession_new(CassCluster* cluster, const char* keyspace)
+{
+  cassandra_psession* psession =
+    (cassandra_psession*) pecalloc(1, sizeof(cassandra_psession), 1);
+
+  psession->cluster   = cluster;
+  psession->keyspace  = keyspace ? pestrdup(keyspace, 1) : NULL;
+  psession->last_used = ++psession_clock;
+
+  php_cassandra_psession_connect(psession);
+
+  return psession;
+}
+
+static void
+php_cassandra_psession_free_closing(cassandra_psession* psession)
+{
+  cass_future_free(psession->close_future);
+  cass_session_free(psession->closing);
+  psession->close_future = NULL;
+  psession->closing      = NULL;
+}
+
+void
+php_cassandra_psession_free(cassandra_psession* psession)
+{
+  if (psession->closing)
+    php_cassandra_psession_free_closing(psession);
+
+  cass_future_free(psession->future);
+  cass_session_free(psession->session);
+
+  if (psession->keyspace)
+    pefree(psession->keyspace, 1);
+
+  if (psession->error)
+    pefree(psession->error, 1);
+
+  pefree(psession, 1);
+}
+
+static void
+php_cassandra_psession_error(cassandra_psession* psession, CassError code,
+                             const char* message, size_t message_len)
+{
+  if (psession->error)
+    pefree(psession->error, 1);
+
+  psession->error      = pemalloc(message_len + 1, 1);
+  memcpy(psession->error, message, message_len);
+  psession->error[message_len] = '\0';
+  psession->error_code = code;
+  psession->rebuild    = cass_true;
+}
+
+void
+php_cassandra_psession_failed(cassandra_psession* psession, CassFuture* future)
+{
+  const char* message;
+  size_t message_len;
+
+  cass_future_error_message(future, &message, &message_len);
+  php_cassandra_psession_error(psession, cass_future_error_code(future),
+                               message, message_len);
+}
+
+int
+php_cassandra_psession_check(cassandra_psession* psession TSRMLS_DC)
+{
+  if (!psession->rebuild) {
+    if (!cass_future_ready(psession->future)) {
+      /* The first connection attempt is waited for by the caller, a rebuilt
+       * session is not used before it is connected. */
+      if (!psession->error)
+        return SUCCESS;
+    } else if (cass_future_error_code(psession->future) != CASS_OK) {
+      php_cassandra_psession_failed(psession, psession->future);
+    } else {
+      cass_uint64_t now = uv_hrtime();
+
+      if (now - psession->checked_at < PHP_CASSANDRA_PSESSION_CHECK_INTERVAL)
+        return SUCCESS;
+
+      psession->checked_at = now;
+
+      {
+        CassMetrics metrics;
+        cass_session_get_metrics(psession->session, &metrics);
+
+        if (metrics.stats.total_connections > 0) {
+          if (psession->error) {
+            pefree(psession->error, 1);
+            psession->error = NULL;
+          }
+          return SUCCESS;
+        }
+      }
+
+      php_cassandra_psession_error(psession, CASS_ERROR_LIB_NO_HOSTS_AVAILABLE,
+                                   ZEND_STRL("No hosts available for the persistent session"));
+    }
+  }
+
+  zend_throw_exception_ex(exception_class(psession->error_code), psession->error_code TSRMLS_CC,
+                          "%s", psession->error);
+  return FAILURE;
+}
+
+void
+php_cassandra_psession_touch(cassandra_psession* psession)
+{
+  psession->last_used = ++psession_clock;
+}
+
+void
+php_cassandra_psession_rebuild(TSRMLS_D)
+{
+  HashPosition pos;
+  zend_rsrc_list_entry* le;
+
+  /* Runs at the end of a request, the old session can't be referred to by
+   * any session object anymore. The error is kept until the new one is
+   * connected. Nothing here waits on the network. */
+  zend_hash_internal_pointer_reset_ex(&EG(persistent_list), &pos);
+  while (zend_hash_get_current_data_ex(&EG(persistent_list), (void**) &le, &pos) == SUCCESS) {
+    if (le->type == php_le_cassandra_session() && le->ptr) {
+      cassandra_psession* psession = (cassandra_psession*) le->ptr;
+
+      if (psession->closing && cass_future_ready(psession->close_future))
+        php_cassandra_psession_free_closing(psession);
+
+      /* A session still closing from the last rebuild delays the next one */
+      if (psession->rebuild && !psession->closing) {
+        cass_future_free(psession->future);
+        psession->closing      = psession->session;
+        psession->close_future = cass_session_close(psession->closing);
+        php_cassandra_psession_connect(psession);
+        psession->rebuild    = cass_false;
+        psession->checked_at = 0;
+      }
+    }
+
+    zend_hash_move_forward_ex(&EG(persistent_list), &pos);
+  }
+}
+
+void
+php_cassandra_psession_evict(long max TSRMLS_DC)
+{
+  if (max <= 0)
+    return;
+
+  /* Runs at the end of a request, once no session object refers to the
+   * persistent sessions anymore. */
+  while (CASSANDRA_G(persistent_sessions) > (unsigned long) max) {
+    HashPosition pos;
+    zend_rsrc_list_entry* le;
+    char* key;
+    uint  key_len;
+    ulong index;
+    char* oldest_key = NULL;
+    uint  oldest_key_len = 0;
+    unsigned long oldest = 0;
+
+    zend_hash_internal_pointer_reset_ex(&EG(persistent_list), &pos);
+    while (zend_hash_get_current_data_ex(&EG(persistent_list), (void**) &le, &pos) == SUCCESS) {
+      if (le->type == php_le_cassandra_session() && le->ptr &&
+          zend_hash_get_current_key_ex(&EG(persistent_list), &key, &key_len, &index, 0, &pos) == HASH_KEY_IS_STRING) {
+        cassandra_psession* psession = (cassandra_psession*) le->ptr;
+
+        if (!oldest_key || psession->last_used < oldest) {
+          oldest_key     = key;
+          oldest_key_len = key_len;
+          oldest         = psession->last_used;
+        }
+      }
+
+      zend_hash_move_forward_ex(&EG(persistent_list), &pos);
+    }
+
+    if (!oldest_key ||
+        zend_hash_del(&EG(persistent_list), oldest_key, oldest_key_len) == FAILURE)
+      break;
+  }
+}
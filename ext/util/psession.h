@@ -0,0 +1,12 @@
+#ifndef PHP_CASSANDRA_UTIL_PSESSION_H
+#define PHP_CASSANDRA_UTIL_PSESSION_H
+
+cassandra_psession* php_cassandra_psession_new(CassCluster* cluster, const char* keyspace);
+void php_cassandra_psession_free(cassandra_psession* psession);
+void php_cassandra_psession_touch(cassandra_psession* psession);
+int  php_cassandra_psession_check(cassandra_psession* psession TSRMLS_DC);
+void php_cassandra_psession_failed(cassandra_psession* psession, CassFuture* future);
+void php_cassandra_psession_rebuild(TSRMLS_D);
+void php_cassandra_psession_evict(long max TSRMLS_DC);
+
+#endif /* PHP_CASSANDRA_UTIL_PSESSION_H */
@@ -0,0 +1,292 @@
+#include "php_cassandra.h"
+#include <uv.h>
+#ifndef _WIN32
+#include <errno.h>
+#include <time.h>
+#include <sys/mman.h>
+#endif
+#include "util/atomic.h"
+#include "util/rate_limit.h"
+
+#define PHP_CASSANDRA_RATE_LIMIT_SLOTS 64
+/* Up to one second worth of requests or bytes can be sent in a burst */
+#define PHP_CASSANDRA_RATE_LIMIT_BURST 1000000000ULL
+
+/* Each bucket is a single theoretical arrival time (GCRA), so taking tokens
+ * is one compare-and-swap and works the same whether the slots are private
+ * to the process or shared by all the workers of a SAPI. */
+typedef struct {
+  volatile cass_uint64_t hash;
+  volatile cass_uint64_t tat;
+} php_cassandra_rate_limit_slot;
+
+static php_cassandra_rate_limit_slot* slots = NULL;
+static int slots_shared = 0;
+
+static cass_uint64_t
+php_cassandra_rate_limit_hash(const char* key)
+{
+  /* FNV-1a */
+  cass_uint64_t hash = 14695981039346656037ULL;
+
+  for (; *key; key++) {
+    hash ^= (unsigned char) *key;
+    hash *= 1099511628211ULL;
+  }
+
+  return hash ? hash : 1;
+}
+
+int
+php_cassandra_rate_limit_startup(zend_bool shared)
+{
+#ifndef _WIN32
+  if (shared) {
+    /* Mapped before the SAPI forks its workers */
+    void* mapped = mmap(NULL, PHP_CASSANDRA_RATE_LIMIT_SLOTS * sizeof(php_cassandra_rate_limit_slot),
+                        PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+
+    if (mapped != MAP_FAILED) {
+      memset(mapped, 0, PHP_CASSANDRA_RATE_LIMIT_SLOTS * sizeof(php_cassandra_rate_limit_slot));
+      slots        = (php_cassandra_rate_limit_slot*) mapped;
+      slots_shared = 1;
+      return SUCCESS;
+    }
+  }
+#endif
+
+  slots = (php_cassandra_rate_limit_slot*)
+    pecalloc(PHP_CASSANDRA_RATE_LIMIT_SLOTS, sizeof(php_cassandra_rate_limit_slot), 1);
+
+  return shared ? FAILURE : SUCCESS;
+}
+
+void
+php_cassandra_rate_limit_shutdown()
+{
+  if (!slots)
+    return;
+
+#ifndef _WIN32
+  if (slots_shared)
+    munmap(slots, PHP_CASSANDRA_RATE_LIMIT_SLOTS * sizeof(php_cassandra_rate_limit_slot));
+  else
+#endif
+    pefree(slots, 1);
+
+  slots        = NULL;
+  slots_shared = 0;
+}
+
+static volatile cass_uint64_t*
+php_cassandra_rate_limit_slot_find(const char* key)
+{
+  cass_uint64_t hash = php_cassandra_rate_limit_hash(key);
+  size_t i;
+
+  if (!slots)
+    return NULL;
+
+  for (i = 0; i < PHP_CASSANDRA_RATE_LIMIT_SLOTS; i++) {
+    php_cassandra_rate_limit_slot* slot =
+      &slots[(hash + i) % PHP_CASSANDRA_RATE_LIMIT_SLOTS];
+
+    if (slot->hash == 0)
+      PHP_CASSANDRA_ATOMIC_CAS(&slot->hash, 0, hash);
+
+    if (slot->hash == hash)
+      return &slot->tat;
+  }
+
+  return NULL;
+}
+
+void
+php_cassandra_rate_limit_init(cassandra_rate_limit* limit, const char* key,
+                              long requests, long bytes, cass_bool_t fail_fast TSRMLS_DC)
+{
+  char* slot_key;
+
+  memset(limit, 0, sizeof(cassandra_rate_limit));
+
+  limit->requests_per_second = requests;
+  limit->bytes_per_second    = bytes;
+  limit->fail_fast           = fail_fast;
+
+  if (requests > 0) {
+    spprintf(&slot_key, 0, "%s:requests:%ld", key, requests);
+    limit->requests = php_cassandra_rate_limit_slot_find(slot_key);
+    efree(slot_key);
+  }
+
+  if (bytes > 0) {
+    spprintf(&slot_key, 0, "%s:bytes:%ld", key, bytes);
+    limit->bytes = php_cassandra_rate_limit_slot_find(slot_key);
+    efree(slot_key);
+  }
+
+  if ((requests > 0 && !limit->requests) || (bytes > 0 && !limit->bytes)) {
+    php_error_docref(NULL TSRMLS_CC, E_WARNING,
+                     "cassandra | No rate limit slot left, requests are not rate limited");
+  }
+}
+
+static size_t
+php_cassandra_rate_limit_arguments_size(HashTable* arguments TSRMLS_DC)
+{
+  HashPosition pos;
+  zval** current;
+  size_t size = 0;
+
+  if (!arguments)
+    return 0;
+
+  zend_hash_internal_pointer_reset_ex(arguments, &pos);
+  while (zend_hash_get_current_data_ex(arguments, (void**) &current, &pos) == SUCCESS) {
+    if (Z_TYPE_PP(current) == IS_STRING) {
+      size += Z_STRLEN_PP(current);
+    } else if (Z_TYPE_PP(current) == IS_OBJECT &&
+               instanceof_function(Z_OBJCE_PP(current), cassandra_blob_ce TSRMLS_CC)) {
+      size += ((cassandra_blob*) zend_object_store_get_object(*current TSRMLS_CC))->size;
+    } else {
+      size += sizeof(cass_int64_t);
+    }
+    zend_hash_move_forward_ex(arguments, &pos);
+  }
+
+  return size;
+}
+
+/* An estimate of the request size: the query and its string, blob and
+ * scalar values. */
+size_t
+php_cassandra_rate_limit_size(cassandra_statement* statement,
+                              HashTable* arguments TSRMLS_DC)
+{
+  HashPosition pos;
+  void** data;
+  size_t size = 0;
+
+  switch (statement->type) {
+    case CASSANDRA_SIMPLE_STATEMENT:
+      size = strlen(((cassandra_simple_statement*) statement)->cql);
+      break;
+    case CASSANDRA_PREPARED_STATEMENT:
+      /* Only the id of the prepared statement is sent */
+      size = 16;
+      break;
+    case CASSANDRA_BOUND_STATEMENT:
+      size = 16;
+      if (((cassandra_bound_statement*) statement)->arguments)
+        size += php_cassandra_rate_limit_arguments_size(
+                  Z_ARRVAL_P(((cassandra_bound_statement*) statement)->arguments) TSRMLS_CC);
+      break;
+    case CASSANDRA_BATCH_STATEMENT:
+      zend_hash_internal_pointer_reset_ex(&((cassandra_batch_statement*) statement)->statements, &pos);
+      while (zend_hash_get_current_data_ex(&((cassandra_batch_statement*) statement)->statements,
+                                           (void**) &data, &pos) == SUCCESS) {
+        cassandra_batch_statement_entry* entry = *((cassandra_batch_statement_entry**) data);
+        size += php_cassandra_rate_limit_size(
+                  (cassandra_statement*) zend_object_store_get_object(entry->statement TSRMLS_CC),
+                  entry->arguments ? Z_ARRVAL_P(entry->arguments) : NULL TSRMLS_CC);
+        zend_hash_move_forward_ex(&((cassandra_batch_statement*) statement)->statements, &pos);
+      }
+      return size;
+  }
+
+  return size + php_cassandra_rate_limit_arguments_size(arguments TSRMLS_CC);
+}
+
+static int
+php_cassandra_rate_limit_reserve(volatile cass_uint64_t* tat, cass_uint64_t cost,
+                                 cass_bool_t fail_fast, cass_uint64_t* wait)
+{
+  cass_uint64_t now = uv_hrtime();
+
+  if (cost > PHP_CASSANDRA_RATE_LIMIT_BURST)
+    cost = PHP_CASSANDRA_RATE_LIMIT_BURST;
+
+  for (;;) {
+    cass_uint64_t current = *tat;
+    cass_uint64_t next    = (current > now ? current : now) + cost;
+    cass_uint64_t delay   = next > now + PHP_CASSANDRA_RATE_LIMIT_BURST
+                          ? next - now - PHP_CASSANDRA_RATE_LIMIT_BURST : 0;
+
+    if (delay > 0 && fail_fast)
+      return FAILURE;
+
+    if (PHP_CASSANDRA_ATOMIC_CAS(tat, current, next)) {
+      if (delay > *wait)
+        *wait = delay;
+      return SUCCESS;
+    }
+  }
+}
+
+/* Gives back tokens taken by a reservation that was not used */
+static void
+php_cassandra_rate_limit_refund(volatile cass_uint64_t* tat, cass_uint64_t cost)
+{
+  if (cost > PHP_CASSANDRA_RATE_LIMIT_BURST)
+    cost = PHP_CASSANDRA_RATE_LIMIT_BURST;
+
+  for (;;) {
+    cass_uint64_t current = *tat;
+
+    if (PHP_CASSANDRA_ATOMIC_CAS(tat, current, current > cost ? current - cost : 0))
+      return;
+  }
+}
+
+static void
+php_cassandra_rate_limit_sleep(cass_uint64_t wait)
+{
+#ifdef _WIN32
+  Sleep((DWORD) (wait / 1000000));
+#else
+  struct timespec delay;
+
+  delay.tv_sec  = wait / 1000000000ULL;
+  delay.tv_nsec = wait % 1000000000ULL;
+
+  while (nanosleep(&delay, &delay) == -1 && errno == EINTR) {}
+#endif
+}
+
+int
+php_cassandra_rate_limit_acquire(cassandra_rate_limit* limit,
+                                 size_t bytes TSRMLS_DC)
+{
+  cass_uint64_t wait = 0;
+  cass_uint64_t bytes_cost = 0;
+
+  if (limit->bytes)
+    bytes_cost = (cass_uint64_t) bytes * 1000000000ULL / limit->bytes_per_second;
+
+  if (limit->bytes &&
+      php_cassandra_rate_limit_reserve(limit->bytes, bytes_cost,
+                                       limit->fail_fast, &wait) == FAILURE) {
+    zend_throw_exception_ex(cassandra_runtime_exception_ce, 0 TSRMLS_CC,
+                            "Rate limit of %ld bytes per second exceeded",
+                            limit->bytes_per_second);
+    return FAILURE;
+  }
+
+  if (limit->requests &&
+      php_cassandra_rate_limit_reserve(limit->requests,
+        1000000000ULL / limit->requests_per_second,
+        limit->fail_fast, &wait) == FAILURE) {
+    /* The request is not sent, so its bytes must not count either */
+    if (limit->bytes)
+      php_cassandra_rate_limit_refund(limit->bytes, bytes_cost);
+    zend_throw_exception_ex(cassandra_runtime_exception_ce, 0 TSRMLS_CC,
+                            "Rate limit of %ld requests per second exceeded",
+                            limit->requests_per_second);
+    return FAILURE;
+  }
+
+  if (wait > 0)
+    php_cassandra_rate_limit_sleep(wait);
+
+  return SUCCESS;
+}
@@ -0,0 +1,13 @@
+#ifndef PHP_CASSANDRA_UTIL_RATE_LIMIT_H
+#define PHP_CASSANDRA_UTIL_RATE_LIMIT_H
+
+int    php_cassandra_rate_limit_startup(zend_bool shared);
+void   php_cassandra_rate_limit_shutdown();
+void   php_cassandra_rate_limit_init(cassandra_rate_limit* limit, const char* key,
+                                     long requests, long bytes, cass_bool_t fail_fast TSRMLS_DC);
+size_t php_cassandra_rate_limit_size(cassandra_statement* statement,
+                                     HashTable* arguments TSRMLS_DC);
+int    php_cassandra_rate_limit_acquire(cassandra_rate_limit* limit,
+                                        size_t bytes TSRMLS_DC);
+
+#endif /* PHP_CASSANDRA_UTIL_RATE_LIMIT_H */
@@ -0,0 +1,500 @@
+#include "php_cassandra.h"
+#include <ext/standard/php_smart_str.h>
+#include "util/collections.h"
+#include "util/recording.h"
+#include "util/result.h"
+#include "src/Cassandra/Collection.h"
+#include "src/Cassandra/Map.h"
+#include "src/Cassandra/Set.h"
+
+ZEND_EXTERN_MODULE_GLOBALS(cassandra)
+
+/* Results are appended to the recording file as self-contained records:
+ *
+ *   "CASR" [uint32 length]
+ *   [uint32 columns] columns * ([uint16 length] name
+ *                               [uint16 type] [uint16 primary] [uint16 secondary])
+ *   [uint32 rows] rows * columns * [int32 length] bytes
+ *
+ * All integers are big-endian and a negative cell length denotes null. Cells
+ * hold the value as sent by the server, except for collections which are
+ * always written with 32-bit element counts and lengths so that recordings
+ * do not depend on the protocol version that was used. */
+#define PHP_CASSANDRA_RECORD_MAGIC "CASR"
+
+static void
+record_uint16(smart_str* out, cass_uint32_t value)
+{
+  smart_str_appendc(out, (char) ((value >> 8) & 0xFF));
+  smart_str_appendc(out, (char) (value & 0xFF));
+}
+
+static void
+record_uint32(smart_str* out, cass_uint32_t value)
+{
+  smart_str_appendc(out, (char) ((value >> 24) & 0xFF));
+  smart_str_appendc(out, (char) ((value >> 16) & 0xFF));
+  smart_str_appendc(out, (char) ((value >> 8) & 0xFF));
+  smart_str_appendc(out, (char) (value & 0xFF));
+}
+
+static void
+record_bytes(smart_str* out, const CassValue* value)
+{
+  const cass_byte_t* data;
+  size_t size;
+
+  if (cass_value_is_null(value) ||
+      cass_value_get_bytes(value, &data, &size) != CASS_OK) {
+    record_uint32(out, (cass_uint32_t) -1);
+    return;
+  }
+
+  record_uint32(out, (cass_uint32_t) size);
+  smart_str_appendl(out, (const char*) data, size);
+}
+
+static void
+record_value(smart_str* out, const CassValue* value, CassValueType type)
+{
+  smart_str elements = { NULL, 0, 0 };
+  CassIterator* iterator;
+  cass_uint32_t count = 0;
+
+  if (cass_value_is_null(value) ||
+      (type != CASS_VALUE_TYPE_LIST &&
+       type != CASS_VALUE_TYPE_SET &&
+       type != CASS_VALUE_TYPE_MAP)) {
+    record_bytes(out, value);
+    return;
+  }
+
+  if (type == CASS_VALUE_TYPE_MAP) {
+    iterator = cass_iterator_from_map(value);
+    while (cass_iterator_next(iterator)) {
+      record_bytes(&elements, cass_iterator_get_map_key(iterator));
+      record_bytes(&elements, cass_iterator_get_map_value(iterator));
+      count++;
+    }
+  } else {
+    iterator = cass_iterator_from_collection(value);
+    while (cass_iterator_next(iterator)) {
+      record_bytes(&elements, cass_iterator_get_value(iterator));
+      count++;
+    }
+  }
+  cass_iterator_free(iterator);
+
+  record_uint32(out, 4 + elements.len);
+  record_uint32(out, count);
+  if (elements.c) {
+    smart_str_appendl(out, elements.c, elements.len);
+    smart_str_free(&elements);
+  }
+}
+
+void
+php_cassandra_record_result(const CassResult* result TSRMLS_DC)
+{
+  smart_str      cells  = { NULL, 0, 0 };
+  smart_str      record = { NULL, 0, 0 };
+  size_t         columns;
+  size_t         rows = 0;
+  size_t         i;
+  CassValueType* primary;
+  CassValueType* secondary;
+  CassIterator*  iterator;
+  php_stream*    stream;
+
+  columns = cass_result_column_count(result);
+
+  /* nothing worth replaying in results of writes and schema changes */
+  if (columns == 0)
+    return;
+
+  primary   = (CassValueType*) emalloc((columns + 1) * sizeof(CassValueType));
+  secondary = (CassValueType*) emalloc((columns + 1) * sizeof(CassValueType));
+
+  /* zero is CASS_VALUE_TYPE_CUSTOM, not a missing sub-type */
+  for (i = 0; i < columns; i++) {
+    primary[i]   = CASS_VALUE_TYPE_UNKNOWN;
+    secondary[i] = CASS_VALUE_TYPE_UNKNOWN;
+  }
+
+  iterator = cass_iterator_from_result(result);
+  while (cass_iterator_next(iterator)) {
+    const CassRow* row = cass_iterator_get_row(iterator);
+
+    for (i = 0; i < columns; i++) {
+      const CassValue* value = cass_row_get_column(row, i);
+      CassValueType    type  = cass_result_column_type(result, i);
+
+      /* Sub-types are only known from values, the first non-null one wins. */
+      if (primary[i] == CASS_VALUE_TYPE_UNKNOWN && !cass_value_is_null(value) &&
+          (type == CASS_VALUE_TYPE_LIST ||
+           type == CASS_VALUE_TYPE_SET ||
+           type == CASS_VALUE_TYPE_MAP)) {
+        primary[i] = cass_value_primary_sub_type(value);
+        if (type == CASS_VALUE_TYPE_MAP)
+          secondary[i] = cass_value_secondary_sub_type(value);
+      }
+
+      record_value(&cells, value, type);
+    }
+    rows++;
+  }
+  cass_iterator_free(iterator);
+
+  smart_str_appendl(&record, PHP_CASSANDRA_RECORD_MAGIC, sizeof(PHP_CASSANDRA_RECORD_MAGIC) - 1);
+  record_uint32(&record, 0);
+  record_uint32(&record, (cass_uint32_t) columns);
+
+  for (i = 0; i < columns; i++) {
+    const char* name;
+    size_t      name_length;
+
+    cass_result_column_name(result, i, &name, &name_length);
+    record_uint16(&record, (cass_uint32_t) name_length);
+    smart_str_appendl(&record, name, name_length);
+    record_uint16(&record, cass_result_column_type(result, i));
+    record_uint16(&record, primary[i]);
+    record_uint16(&record, secondary[i]);
+  }
+
+  record_uint32(&record, (cass_uint32_t) rows);
+  if (cells.c) {
+    smart_str_appendl(&record, cells.c, cells.len);
+    smart_str_free(&cells);
+  }
+
+  /* patch in the length of the record following its header */
+  record.c[4] = (char) (((record.len - 8) >> 24) & 0xFF);
+  record.c[5] = (char) (((record.len - 8) >> 16) & 0xFF);
+  record.c[6] = (char) (((record.len - 8) >> 8) & 0xFF);
+  record.c[7] = (char) ((record.len - 8) & 0xFF);
+
+  efree(primary);
+  efree(secondary);
+
+  /* A single append per record keeps records from concurrent processes
+   * from interleaving. */
+  stream = php_stream_open_wrapper(CASSANDRA_G(record_results), "ab",
+                                   REPORT_ERRORS, NULL);
+  if (stream) {
+    php_stream_write(stream, record.c, record.len);
+    php_stream_close(stream);
+  }
+
+  smart_str_free(&record);
+}
+
+typedef struct {
+  const unsigned char* data;
+  size_t               size;
+  size_t               position;
+} replay_buffer;
+
+static int
+replay_read(replay_buffer* buffer, size_t size, const unsigned char** out)
+{
+  if (buffer->size - buffer->position < size)
+    return FAILURE;
+
+  *out = buffer->data + buffer->position;
+  buffer->position += size;
+  return SUCCESS;
+}
+
+static int
+replay_uint16(replay_buffer* buffer, cass_uint32_t* out)
+{
+  const unsigned char* data;
+
+  if (replay_read(buffer, 2, &data) == FAILURE)
+    return FAILURE;
+
+  *out = ((cass_uint32_t) data[0] << 8) | data[1];
+  return SUCCESS;
+}
+
+static int
+replay_uint32(replay_buffer* buffer, cass_uint32_t* out)
+{
+  const unsigned char* data;
+
+  if (replay_read(buffer, 4, &data) == FAILURE)
+    return FAILURE;
+
+  *out = ((cass_uint32_t) data[0] << 24) | ((cass_uint32_t) data[1] << 16) |
+         ((cass_uint32_t) data[2] << 8)  |  (cass_uint32_t) data[3];
+  return SUCCESS;
+}
+
+static int
+replay_cell(replay_buffer* buffer, replay_buffer* cell, int* is_null)
+{
+  cass_uint32_t        size;
+  const unsigned char* data;
+
+  if (replay_uint32(buffer, &size) == FAILURE)
+    return FAILURE;
+
+  *is_null = (cass_int32_t) size < 0;
+  if (*is_null)
+    return SUCCESS;
+
+  if (replay_read(buffer, size, &data) == FAILURE)
+    return FAILURE;
+
+  cell->data     = data;
+  cell->size     = size;
+  cell->position = 0;
+  return SUCCESS;
+}
+
+static int
+replay_value(replay_buffer* cell, int is_null,
+             CassValueType type, CassValueType primary, CassValueType secondary,
+             zval** out TSRMLS_DC);
+
+static int
+replay_elements(replay_buffer* cell, CassValueType type,
+                CassValueType primary, CassValueType secondary,
+                zval* return_value TSRMLS_DC)
+{
+  cass_uint32_t count;
+  cass_uint32_t i;
+
+  if (replay_uint32(cell, &count) == FAILURE)
+    return FAILURE;
+
+  for (i = 0; i < count; i++) {
+    replay_buffer element;
+    int           is_null;
+    zval*         k;
+    zval*         v;
+
+    if (type == CASS_VALUE_TYPE_MAP) {
+      if (replay_cell(cell, &element, &is_null) == FAILURE ||
+          replay_value(&element, is_null, primary, CASS_VALUE_TYPE_UNKNOWN,
+                       CASS_VALUE_TYPE_UNKNOWN, &k TSRMLS_CC) == FAILURE)
+        return FAILURE;
+
+      if (replay_cell(cell, &element, &is_null) == FAILURE ||
+          replay_value(&element, is_null, secondary, CASS_VALUE_TYPE_UNKNOWN,
+                       CASS_VALUE_TYPE_UNKNOWN, &v TSRMLS_CC) == FAILURE) {
+        zval_ptr_dtor(&k);
+        return FAILURE;
+      }
+
+      php_cassandra_map_set((cassandra_map*) zend_object_store_get_object(return_value TSRMLS_CC),
+                            k, v TSRMLS_CC);
+      zval_ptr_dtor(&k);
+      zval_ptr_dtor(&v);
+      continue;
+    }
+
+    if (replay_cell(cell, &element, &is_null) == FAILURE ||
+        replay_value(&element, is_null, primary, CASS_VALUE_TYPE_UNKNOWN,
+                     CASS_VALUE_TYPE_UNKNOWN, &v TSRMLS_CC) == FAILURE)
+      return FAILURE;
+
+    if (type == CASS_VALUE_TYPE_SET) {
+      php_cassandra_set_add((cassandra_set*) zend_object_store_get_object(return_value TSRMLS_CC),
+                            v TSRMLS_CC);
+    } else {
+      php_cassandra_collection_add((cassandra_collection*) zend_object_store_get_object(return_value TSRMLS_CC),
+                                   v TSRMLS_CC);
+    }
+    zval_ptr_dtor(&v);
+  }
+
+  return SUCCESS;
+}
+
+/* Only collections are rebuilt here, every other value is decoded by the
+ * same function as results received from the server. */
+static int
+replay_value(replay_buffer* cell, int is_null,
+             CassValueType type, CassValueType primary, CassValueType secondary,
+             zval** out TSRMLS_DC)
+{
+  zval*          return_value;
+  cassandra_map* map;
+
+  if (is_null) {
+    MAKE_STD_ZVAL(*out);
+    ZVAL_NULL(*out);
+    return SUCCESS;
+  }
+
+  if (type != CASS_VALUE_TYPE_LIST &&
+      type != CASS_VALUE_TYPE_SET &&
+      type != CASS_VALUE_TYPE_MAP)
+    return php_cassandra_value_from_bytes(cell->data, cell->size, type, out TSRMLS_CC);
+
+  MAKE_STD_ZVAL(return_value);
+
+  switch (type) {
+  case CASS_VALUE_TYPE_LIST:
+    object_init_ex(return_value, cassandra_collection_ce);
+    ((cassandra_collection*) zend_object_store_get_object(return_value TSRMLS_CC))->type = primary;
+    break;
+  case CASS_VALUE_TYPE_SET:
+    object_init_ex(return_value, cassandra_set_ce);
+    ((cassandra_set*) zend_object_store_get_object(return_value TSRMLS_CC))->type = primary;
+    break;
+  default:
+    object_init_ex(return_value, cassandra_map_ce);
+    map = (cassandra_map*) zend_object_store_get_object(return_value TSRMLS_CC);
+    map->key_type   = primary;
+    map->value_type = secondary;
+    break;
+  }
+
+  if (replay_elements(cell, type, primary, secondary, return_value TSRMLS_CC) == FAILURE) {
+    zval_ptr_dtor(&return_value);
+    return FAILURE;
+  }
+
+  *out = return_value;
+  return SUCCESS;
+}
+
+static int
+replay_record(replay_buffer* buffer, zval* rows TSRMLS_DC)
+{
+  cass_uint32_t  columns;
+  cass_uint32_t  count;
+  cass_uint32_t  i;
+  cass_uint32_t  j;
+  char**         names;
+  CassValueType* types;
+  int            result = FAILURE;
+
+  if (replay_uint32(buffer, &columns) == FAILURE ||
+      columns > buffer->size - buffer->position)
+    return FAILURE;
+
+  names = (char**) ecalloc(columns + 1, sizeof(char*));
+  types = (CassValueType*) ecalloc(3 * (columns + 1), sizeof(CassValueType));
+
+  for (i = 0; i < columns; i++) {
+    cass_uint32_t        length;
+    cass_uint32_t        type;
+    const unsigned char* name;
+
+    if (replay_uint16(buffer, &length) == FAILURE ||
+        replay_read(buffer, length, &name) == FAILURE)
+      goto cleanup;
+
+    names[i] = estrndup((const char*) name, length);
+
+    for (j = 0; j < 3; j++) {
+      if (replay_uint16(buffer, &type) == FAILURE)
+        goto cleanup;
+      types[3 * i + j] = (CassValueType) type;
+    }
+  }
+
+  if (replay_uint32(buffer, &count) == FAILURE)
+    goto cleanup;
+
+  for (j = 0; j < count; j++) {
+    zval* row;
+
+    MAKE_STD_ZVAL(row);
+    array_init(row);
+    add_next_index_zval(rows, row);
+
+    for (i = 0; i < columns; i++) {
+      replay_buffer cell;
+      int           is_null;
+      zval*         value;
+
+      if (replay_cell(buffer, &cell, &is_null) == FAILURE ||
+          replay_value(&cell, is_null, types[3 * i], types[3 * i + 1],
+                       types[3 * i + 2], &value TSRMLS_CC) == FAILURE)
+        goto cleanup;
+
+      add_assoc_zval_ex(row, names[i], strlen(names[i]) + 1, value);
+    }
+  }
+
+  result = SUCCESS;
+
+cleanup:
+  for (i = 0; i < columns; i++) {
+    if (names[i])
+      efree(names[i]);
+  }
+  efree(names);
+  efree(types);
+
+  return result;
+}
+
+int
+php_cassandra_replay(const char* filename, zval* out TSRMLS_DC)
+{
+  php_stream*   stream;
+  char*         contents = NULL;
+  size_t        size;
+  replay_buffer buffer;
+
+  stream = php_stream_open_wrapper((char*) filename, "rb", REPORT_ERRORS, NULL);
+  if (!stream) {
+    zend_throw_exception_ex(cassandra_runtime_exception_ce, 0 TSRMLS_CC,
+                            "Unable to open recording %s", filename);
+    return FAILURE;
+  }
+
+  size = php_stream_copy_to_mem(stream, &contents, PHP_STREAM_COPY_ALL, 0);
+  php_stream_close(stream);
+
+  buffer.data     = (const unsigned char*) contents;
+  buffer.size     = contents ? size : 0;
+  buffer.position = 0;
+
+  array_init(out);
+
+  while (buffer.position < buffer.size) {
+    const unsigned char* magic;
+    cass_uint32_t        length;
+    replay_buffer        record;
+    zval*                rows;
+
+    if (replay_read(&buffer, 4, &magic) == FAILURE ||
+        memcmp(magic, PHP_CASSANDRA_RECORD_MAGIC, 4) != 0 ||
+        replay_uint32(&buffer, &length) == FAILURE ||
+        replay_read(&buffer, length, &record.data) == FAILURE) {
+      goto corrupted;
+    }
+
+    record.size     = length;
+    record.position = 0;
+
+    MAKE_STD_ZVAL(rows);
+    array_init(rows);
+    add_next_index_zval(out, rows);
+
+    if (replay_record(&record, rows TSRMLS_CC) == FAILURE)
+      goto corrupted;
+  }
+
+  if (contents)
+    efree(contents);
+
+  return SUCCESS;
+
+corrupted:
+  zend_throw_exception_ex(cassandra_runtime_exception_ce, 0 TSRMLS_CC,
+                          "Corrupted recording %s at offset %lu", filename,
+                          (unsigned long) buffer.position);
+  zval_dtor(out);
+  ZVAL_NULL(out);
+  if (contents)
+    efree(contents);
+
+  return FAILURE;
+}
@@ -0,0 +1,7 @@
+#ifndef PHP_CASSANDRA_UTIL_RECORDING_H
+#define PHP_CASSANDRA_UTIL_RECORDING_H
+
+void php_cassandra_record_result(const CassResult* result TSRMLS_DC);
+int  php_cassandra_replay(const char* filename, zval* out TSRMLS_DC);
+
+#endif /* PHP_CASSANDRA_UTIL_RECORDING_H */
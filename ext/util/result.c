@@ -1,27 +1,39 @@
 #include "php_cassandra.h"
+#include <uv.h>
 #include "result.h"
 #include "math.h"
 #include "collections.h"
+#include "metrics.h"
+#include "recording.h"
 #include "src/Cassandra/Collection.h"
 #include "src/Cassandra/Map.h"
 #include "src/Cassandra/Set.h"
 
-static int
-php_cassandra_value(const CassValue* value, CassValueType type, zval** out TSRMLS_DC)
+ZEND_EXTERN_MODULE_GLOBALS(cassandra)
+
+static cass_uint32_t
+php_cassandra_decode_uint32(const cass_byte_t* data)
+{
+  return ((cass_uint32_t) data[0] << 24) | ((cass_uint32_t) data[1] << 16) |
+         ((cass_uint32_t) data[2] << 8)  |  (cass_uint32_t) data[3];
+}
+
+static cass_uint64_t
+php_cassandra_decode_uint64(const cass_byte_t* data)
+{
+  return ((cass_uint64_t) php_cassandra_decode_uint32(data) << 32) |
+          (cass_uint64_t) php_cassandra_decode_uint32(data + 4);
+}
+
+int
+php_cassandra_value_from_bytes(const cass_byte_t* data, size_t size,
+                               CassValueType type, zval** out TSRMLS_DC)
 {
   zval* return_value;
-  const char* v_string;
-  size_t v_string_len;
-  const cass_byte_t* v_bytes;
-  size_t v_bytes_len;
-  const cass_byte_t* v_decimal;
-  size_t v_decimal_len;
-  cass_int32_t v_decimal_scale;
-  cass_int32_t v_int_32;
-  cass_bool_t v_boolean;
+  cass_uint32_t v_int_32;
+  cass_uint64_t v_int_64;
   cass_double_t v_double;
   cassandra_uuid* uuid;
-  CassIterator* iterator;
   cassandra_bigint* bigint_number = NULL;
   cassandra_timestamp* timestamp = NULL;
   cassandra_blob* blob = NULL;
@@ -29,132 +41,140 @@ php_cassandra_value(const CassValue* value, CassValueType type, zval** out TSRML
   cassandra_inet* inet = NULL;
   cassandra_decimal* decimal_number = NULL;
   cassandra_float* float_number = NULL;
-  cassandra_collection* collection = NULL;
-  cassandra_map* map = NULL;
-  cassandra_set* set = NULL;
 
   MAKE_STD_ZVAL(return_value);
   RETVAL_NULL();
 
-  if (cass_value_is_null(value)) {
-    *out = return_value;
-    return SUCCESS;
+#define EXPECT_SIZE(condition) \
+  if (!(condition)) { \
+    zval_ptr_dtor(&return_value); \
+    return FAILURE; \
   }
 
   switch (type) {
   case CASS_VALUE_TYPE_ASCII:
   case CASS_VALUE_TYPE_TEXT:
   case CASS_VALUE_TYPE_VARCHAR:
-    ASSERT_SUCCESS_BLOCK(cass_value_get_string(value, &v_string, &v_string_len),
-      zval_ptr_dtor(&return_value);
-      return FAILURE;
-    );
-    RETVAL_STRINGL(v_string, v_string_len, 1);
+    RETVAL_STRINGL((const char*) data, size, 1);
     break;
   case CASS_VALUE_TYPE_INT:
-    ASSERT_SUCCESS_BLOCK(cass_value_get_int32(value, &v_int_32),
-      zval_ptr_dtor(&return_value);
-      return FAILURE;
-    );
-    RETVAL_LONG(v_int_32);
+    EXPECT_SIZE(size == 4);
+    RETVAL_LONG((cass_int32_t) php_cassandra_decode_uint32(data));
     break;
   case CASS_VALUE_TYPE_COUNTER:
   case CASS_VALUE_TYPE_BIGINT:
+    EXPECT_SIZE(size == 8);
     object_init_ex(return_value, cassandra_bigint_ce);
     bigint_number = (cassandra_bigint*) zend_object_store_get_object(return_value TSRMLS_CC);
-    ASSERT_SUCCESS_BLOCK(cass_value_get_int64(value, &bigint_number->value),
-      zval_ptr_dtor(&return_value);
-      return FAILURE;
-    )
+    bigint_number->value = (cass_int64_t) php_cassandra_decode_uint64(data);
     break;
   case CASS_VALUE_TYPE_TIMESTAMP:
+    EXPECT_SIZE(size == 8);
     object_init_ex(return_value, cassandra_timestamp_ce);
     timestamp = (cassandra_timestamp*) zend_object_store_get_object(return_value TSRMLS_CC);
-    ASSERT_SUCCESS_BLOCK(cass_value_get_int64(value, &timestamp->timestamp),
-      zval_ptr_dtor(&return_value);
-      return FAILURE;
-    )
+    timestamp->timestamp = (cass_int64_t) php_cassandra_decode_uint64(data);
     break;
   case CASS_VALUE_TYPE_BLOB:
     object_init_ex(return_value, cassandra_blob_ce);
     blob = (cassandra_blob*) zend_object_store_get_object(return_value TSRMLS_CC);
-    ASSERT_SUCCESS_BLOCK(cass_value_get_bytes(value, &v_bytes, &v_bytes_len),
-      zval_ptr_dtor(&return_value);
-      return FAILURE;
-    )
-    blob->data = emalloc(v_bytes_len * sizeof(cass_byte_t));
-    blob->size = v_bytes_len;
-    memcpy(blob->data, v_bytes, v_bytes_len);
+    blob->data = emalloc(size * sizeof(cass_byte_t));
+    blob->size = size;
+    memcpy(blob->data, data, size);
     break;
   case CASS_VALUE_TYPE_VARINT:
-    ASSERT_SUCCESS_BLOCK(cass_value_get_bytes(value, &v_bytes, &v_bytes_len),
-      zval_ptr_dtor(&return_value);
-      return FAILURE;
-    );
     object_init_ex(return_value, cassandra_varint_ce);
     varint_number = (cassandra_varint*) zend_object_store_get_object(return_value TSRMLS_CC);
-    import_twos_complement((cass_byte_t*) v_bytes, v_bytes_len, &varint_number->value);
+    import_twos_complement((cass_byte_t*) data, size, &varint_number->value);
     break;
   case CASS_VALUE_TYPE_UUID:
-    object_init_ex(return_value, cassandra_uuid_ce);
-    uuid = (cassandra_uuid*) zend_object_store_get_object(return_value TSRMLS_CC);
-    ASSERT_SUCCESS_BLOCK(cass_value_get_uuid(value, &uuid->uuid),
-      zval_ptr_dtor(&return_value);
-      return FAILURE;
-    )
-    break;
   case CASS_VALUE_TYPE_TIMEUUID:
-    object_init_ex(return_value, cassandra_timeuuid_ce);
+    EXPECT_SIZE(size == 16);
+    object_init_ex(return_value, type == CASS_VALUE_TYPE_UUID ? cassandra_uuid_ce : cassandra_timeuuid_ce);
     uuid = (cassandra_uuid*) zend_object_store_get_object(return_value TSRMLS_CC);
-    ASSERT_SUCCESS_BLOCK(cass_value_get_uuid(value, &uuid->uuid),
-      zval_ptr_dtor(&return_value);
-      return FAILURE;
-    )
+    uuid->uuid.time_and_version  = (cass_uint64_t) php_cassandra_decode_uint32(data);
+    uuid->uuid.time_and_version |= ((cass_uint64_t) data[4] << 40) | ((cass_uint64_t) data[5] << 32);
+    uuid->uuid.time_and_version |= ((cass_uint64_t) data[6] << 56) | ((cass_uint64_t) data[7] << 48);
+    uuid->uuid.clock_seq_and_node = php_cassandra_decode_uint64(data + 8);
     break;
   case CASS_VALUE_TYPE_BOOLEAN:
-    ASSERT_SUCCESS_BLOCK(cass_value_get_bool(value, &v_boolean),
-      zval_ptr_dtor(&return_value);
-      return FAILURE;
-    );
-    if (v_boolean) {
+    EXPECT_SIZE(size == 1);
+    if (data[0]) {
       RETVAL_TRUE;
     } else {
       RETVAL_FALSE;
     }
     break;
   case CASS_VALUE_TYPE_INET:
+    EXPECT_SIZE(size == 4 || size == 16);
     object_init_ex(return_value, cassandra_inet_ce);
     inet = (cassandra_inet*) zend_object_store_get_object(return_value TSRMLS_CC);
-    ASSERT_SUCCESS_BLOCK(cass_value_get_inet(value, &inet->inet),
-      zval_ptr_dtor(&return_value);
-      return FAILURE;
-    )
+    memcpy(inet->inet.address, data, size);
+    inet->inet.address_length = size;
     break;
   case CASS_VALUE_TYPE_DECIMAL:
-    ASSERT_SUCCESS_BLOCK(cass_value_get_decimal(value, &v_decimal, &v_decimal_len, &v_decimal_scale),
-      zval_ptr_dtor(&return_value);
-      return FAILURE;
-    );
+    EXPECT_SIZE(size >= 4);
     object_init_ex(return_value, cassandra_decimal_ce);
     decimal_number = (cassandra_decimal*) zend_object_store_get_object(return_value TSRMLS_CC);
-    import_twos_complement((cass_byte_t*) v_decimal, v_decimal_len, &decimal_number->value);
-    decimal_number->scale = v_decimal_scale;
+    import_twos_complement((cass_byte_t*) data + 4, size - 4, &decimal_number->value);
+    decimal_number->scale = (cass_int32_t) php_cassandra_decode_uint32(data);
     break;
   case CASS_VALUE_TYPE_DOUBLE:
-    ASSERT_SUCCESS_BLOCK(cass_value_get_double(value, &v_double),
-      zval_ptr_dtor(&return_value);
-      return FAILURE;
-    );
+    EXPECT_SIZE(size == 8);
+    v_int_64 = php_cassandra_decode_uint64(data);
+    memcpy(&v_double, &v_int_64, sizeof(v_double));
     RETVAL_DOUBLE(v_double);
     break;
   case CASS_VALUE_TYPE_FLOAT:
+    EXPECT_SIZE(size == 4);
     object_init_ex(return_value, cassandra_float_ce);
     float_number = (cassandra_float*) zend_object_store_get_object(return_value TSRMLS_CC);
-    ASSERT_SUCCESS_BLOCK(cass_value_get_float(value, &float_number->value),
-      zval_ptr_dtor(&return_value);
-      return FAILURE;
-    )
+    v_int_32 = php_cassandra_decode_uint32(data);
+    memcpy(&float_number->value, &v_int_32, sizeof(float_number->value));
     break;
+  default:
+    RETVAL_NULL();
+  }
+#undef EXPECT_SIZE
+
+  *out = return_value;
+  return SUCCESS;
+}
+
+/* Adds the size of the value as received from the server to *bytes unless
+ * it is NULL. */
+static int
+php_cassandra_value(const CassValue* value, CassValueType type, size_t* bytes,
+                    zval** out TSRMLS_DC)
+{
+  zval* return_value;
+  const cass_byte_t* v_bytes;
+  size_t v_bytes_len;
+  CassIterator* iterator;
+  cassandra_collection* collection = NULL;
+  cassandra_map* map = NULL;
+  cassandra_set* set = NULL;
+
+  if (cass_value_is_null(value)) {
+    MAKE_STD_ZVAL(*out);
+    ZVAL_NULL(*out);
+    return SUCCESS;
+  }
+
+  if (type != CASS_VALUE_TYPE_LIST &&
+      type != CASS_VALUE_TYPE_MAP &&
+      type != CASS_VALUE_TYPE_SET) {
+    ASSERT_SUCCESS_VALUE(cass_value_get_bytes(value, &v_bytes, &v_bytes_len), FAILURE);
+    if (bytes)
+      *bytes += v_bytes_len;
+    return php_cassandra_value_from_bytes(v_bytes, v_bytes_len, type, out TSRMLS_CC);
+  }
+
+  if (bytes && cass_value_get_bytes(value, &v_bytes, &v_bytes_len) == CASS_OK)
+    *bytes += v_bytes_len;
+
+  MAKE_STD_ZVAL(return_value);
+
+  switch (type) {
   case CASS_VALUE_TYPE_LIST:
     object_init_ex(return_value, cassandra_collection_ce);
     collection = (cassandra_collection*) zend_object_store_get_object(return_value TSRMLS_CC);
@@ -165,7 +185,7 @@ php_cassandra_value(const CassValue* value, CassValueType type, zval** out TSRML
     while (cass_iterator_next(iterator)) {
       zval *v;
 
-      if (php_cassandra_value(cass_iterator_get_value(iterator), collection->type, &v TSRMLS_CC) == FAILURE) {
+      if (php_cassandra_value(cass_iterator_get_value(iterator), collection->type, NULL, &v TSRMLS_CC) == FAILURE) {
         cass_iterator_free(iterator);
         zval_ptr_dtor(&return_value);
         return FAILURE;
@@ -189,8 +209,8 @@ php_cassandra_value(const CassValue* value, CassValueType type, zval** out TSRML
       zval* k;
       zval* v;
 
-      if (php_cassandra_value(cass_iterator_get_map_key(iterator), map->key_type, &k TSRMLS_CC) == FAILURE ||
-          php_cassandra_value(cass_iterator_get_map_value(iterator), map->value_type, &v TSRMLS_CC) == FAILURE) {
+      if (php_cassandra_value(cass_iterator_get_map_key(iterator), map->key_type, NULL, &k TSRMLS_CC) == FAILURE ||
+          php_cassandra_value(cass_iterator_get_map_value(iterator), map->value_type, NULL, &v TSRMLS_CC) == FAILURE) {
         cass_iterator_free(iterator);
         zval_ptr_dtor(&return_value);
         return FAILURE;
@@ -213,7 +233,7 @@ php_cassandra_value(const CassValue* value, CassValueType type, zval** out TSRML
     while (cass_iterator_next(iterator)) {
       zval* v;
 
-      if (php_cassandra_value(cass_iterator_get_value(iterator), set->type, &v TSRMLS_CC) == FAILURE) {
+      if (php_cassandra_value(cass_iterator_get_value(iterator), set->type, NULL, &v TSRMLS_CC) == FAILURE) {
         cass_iterator_free(iterator);
         zval_ptr_dtor(&return_value);
         return FAILURE;
@@ -226,7 +246,7 @@ php_cassandra_value(const CassValue* value, CassValueType type, zval** out TSRML
     cass_iterator_free(iterator);
     break;
   default:
-    RETVAL_NULL();
+    break;
   }
 
   *out = return_value;
@@ -247,7 +267,7 @@ php_cassandra_get_keyspace_field(const CassKeyspaceMeta* metadata, const char* f
     return SUCCESS;
   }
 
-  return php_cassandra_value(value, cass_value_type(value), out TSRMLS_CC);
+  return php_cassandra_value(value, cass_value_type(value), NULL, out TSRMLS_CC);
 }
 
 int
@@ -263,7 +283,7 @@ php_cassandra_get_table_field(const CassTableMeta* metadata, const char* field_n
     return SUCCESS;
   }
 
-  return php_cassandra_value(value, cass_value_type(value), out TSRMLS_CC);
+  return php_cassandra_value(value, cass_value_type(value), NULL, out TSRMLS_CC);
 }
 
 int
@@ -279,7 +299,7 @@ php_cassandra_get_column_field(const CassColumnMeta* metadata, const char* field
     return SUCCESS;
   }
 
-  return php_cassandra_value(value, cass_value_type(value), out TSRMLS_CC);
+  return php_cassandra_value(value, cass_value_type(value), NULL, out TSRMLS_CC);
 }
 #else
 int
@@ -304,12 +324,13 @@ php_cassandra_get_schema_field(const CassSchemaMeta* metadata, const char* field
     return SUCCESS;
   }
 
-  return php_cassandra_value(value, cass_value_type(value), out TSRMLS_CC);
+  return php_cassandra_value(value, cass_value_type(value), NULL, out TSRMLS_CC);
 }
 #endif
 
 int
-php_cassandra_get_result(const CassResult* result, zval** out TSRMLS_DC)
+php_cassandra_get_result(const CassResult* result, zval** out,
+                         size_t* size TSRMLS_DC)
 {
   zval*            rows;
   zval*            row;
@@ -322,6 +343,19 @@ php_cassandra_get_result(const CassResult* result, zval** out TSRMLS_DC)
   size_t           columns = -1;
   char**           column_names;
   unsigned         i;
+  cass_uint64_t    start = 0;
+  size_t           bytes = 0;
+  size_t*          bytes_ptr = NULL;
+
+  if (CASSANDRA_G(record_results) && *CASSANDRA_G(record_results))
+    php_cassandra_record_result(result TSRMLS_CC);
+
+  /* Rows, bytes and time spent decoding are only counted when enabled */
+  if (CASSANDRA_G(metrics))
+    start = uv_hrtime();
+
+  if (size || CASSANDRA_G(metrics))
+    bytes_ptr = &bytes;
 
   MAKE_STD_ZVAL(rows);
   array_init(rows);
@@ -347,7 +381,7 @@ php_cassandra_get_result(const CassResult* result, zval** out TSRMLS_DC)
       column_type  = cass_result_column_type(result, i);
       column_value = cass_row_get_column(cass_row, i);
 
-      if (php_cassandra_value(column_value, column_type, &php_value TSRMLS_CC) == FAILURE) {
+      if (php_cassandra_value(column_value, column_type, bytes_ptr, &php_value TSRMLS_CC) == FAILURE) {
         zval_ptr_dtor(&row);
         zval_ptr_dtor(&rows);
 
@@ -378,6 +412,15 @@ php_cassandra_get_result(const CassResult* result, zval** out TSRMLS_DC)
   efree(column_names);
   cass_iterator_free(iterator);
 
+  if (CASSANDRA_G(metrics)) {
+    PHP_CASSANDRA_COUNTER_ADD(decoded_rows, zend_hash_num_elements(Z_ARRVAL_P(rows)));
+    PHP_CASSANDRA_COUNTER_ADD(decoded_bytes, bytes);
+    PHP_CASSANDRA_COUNTER_ADD(decode_time, uv_hrtime() - start);
+  }
+
+  if (size)
+    *size = bytes;
+
   *out = rows;
 
   return SUCCESS;
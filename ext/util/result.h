@@ -12,6 +12,13 @@ int php_cassandra_get_schema_field(const CassSchemaMeta* metadata, const char* f
 #define php_cassandra_get_column_field php_cassandra_get_schema_field
 #endif
 
-int php_cassandra_get_result(const CassResult* result, zval** out TSRMLS_DC);
+/* Decodes the bytes of a non-null value of a type other than a collection,
+ * used for results from the server as well as for replayed recordings. */
+int php_cassandra_value_from_bytes(const cass_byte_t* data, size_t size,
+                                   CassValueType type, zval** out TSRMLS_DC);
+/* Decodes all the rows of a result. When size is not NULL, it receives the
+ * number of value bytes decoded. */
+int php_cassandra_get_result(const CassResult* result, zval** out,
+                             size_t* size TSRMLS_DC);
 
 #endif /* PHP_CASSANDRA_RESULT_H */
@@ -0,0 +1,83 @@
+#include "php_cassandra.h"
+#include "util/ref.h"
+#include "util/schema.h"
+#include "util/types.h"
+
+typedef struct {
+  zval* type;
+  int   reversed;
+  int   frozen;
+} cassandra_column_type;
+
+static void
+free_column_type(void* data)
+{
+  cassandra_column_type* column_type = (cassandra_column_type*) data;
+
+  zval_ptr_dtor(&column_type->type);
+}
+
+static void
+free_schema(void* data)
+{
+  cassandra_schema_snapshot* snapshot = (cassandra_schema_snapshot*) data;
+
+  zend_hash_destroy(&snapshot->column_types);
+#if CURRENT_CPP_DRIVER_VERSION >= CPP_DRIVER_VERSION(2, 2, 0)
+  cass_schema_meta_free(snapshot->meta);
+#else
+  cass_schema_free(snapshot->meta);
+#endif
+  efree(snapshot);
+}
+
+cassandra_ref*
+php_cassandra_schema_new(cassandra_schema_meta* meta)
+{
+  cassandra_schema_snapshot* snapshot =
+    (cassandra_schema_snapshot*) emalloc(sizeof(cassandra_schema_snapshot));
+
+  snapshot->meta = meta;
+  zend_hash_init(&snapshot->column_types, 0, NULL, free_column_type, 0);
+
+  return php_cassandra_new_ref(snapshot, free_schema);
+}
+
+int
+php_cassandra_schema_column_type(cassandra_ref* schema,
+                                 const char*    validator,
+                                 size_t         validator_len,
+                                 int*           reversed_out,
+                                 int*           frozen_out,
+                                 zval**         type_out TSRMLS_DC)
+{
+  cassandra_schema_snapshot* snapshot = (cassandra_schema_snapshot*) schema->data;
+  cassandra_column_type*     cached;
+  cassandra_column_type      column_type;
+
+  /* Validators are parsed at most once per snapshot, which is immutable. */
+  if (zend_hash_find(&snapshot->column_types, validator, validator_len,
+                     (void**) &cached) == SUCCESS) {
+    Z_ADDREF_P(cached->type);
+    *type_out     = cached->type;
+    *reversed_out = cached->reversed;
+    *frozen_out   = cached->frozen;
+    return SUCCESS;
+  }
+
+  if (php_cassandra_parse_column_type(validator, validator_len,
+                                      &column_type.reversed, &column_type.frozen,
+                                      &column_type.type TSRMLS_CC) == FAILURE) {
+    return FAILURE;
+  }
+
+  zend_hash_add(&snapshot->column_types, validator, validator_len,
+                &column_type, sizeof(cassandra_column_type), NULL);
+
+  Z_ADDREF_P(column_type.type);
+  *type_out     = column_type.type;
+  *reversed_out = column_type.reversed;
+  *frozen_out   = column_type.frozen;
+
+  return SUCCESS;
+}
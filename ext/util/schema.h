@@ -0,0 +1,12 @@
+#ifndef PHP_CASSANDRA_UTIL_SCHEMA_H
+#define PHP_CASSANDRA_UTIL_SCHEMA_H
+
+cassandra_ref* php_cassandra_schema_new(cassandra_schema_meta* meta);
+int php_cassandra_schema_column_type(cassandra_ref* schema,
+                                     const char*    validator,
+                                     size_t         validator_len,
+                                     int*           reversed_out,
+                                     int*           frozen_out,
+                                     zval**         type_out TSRMLS_DC);
+
+#endif /* PHP_CASSANDRA_UTIL_SCHEMA_H */
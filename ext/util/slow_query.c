@@ -0,0 +1,165 @@
+#include "php_cassandra.h"
+#include <ext/standard/php_smart_str.h>
+#include "util/async_log.h"
+#include "util/consistency.h"
+#include "util/execution_info.h"
+#include "util/slow_query.h"
+#include "util/stats.h"
+
+#define PHP_CASSANDRA_SLOW_QUERY_MAX_ARGUMENT  64
+#define PHP_CASSANDRA_SLOW_QUERY_MAX_ARGUMENTS 512
+
+ZEND_EXTERN_MODULE_GLOBALS(cassandra)
+
+static const char*
+php_cassandra_slow_query_cql(zval* statement TSRMLS_DC)
+{
+  cassandra_statement* stmt =
+    (cassandra_statement*) zend_object_store_get_object(statement TSRMLS_CC);
+
+  switch (stmt->type) {
+    case CASSANDRA_SIMPLE_STATEMENT:
+      return ((cassandra_simple_statement*) stmt)->cql;
+    case CASSANDRA_PREPARED_STATEMENT:
+      return ((cassandra_prepared_statement*) stmt)->cql;
+    case CASSANDRA_BOUND_STATEMENT:
+      return ((cassandra_prepared_statement*) zend_object_store_get_object(
+                ((cassandra_bound_statement*) stmt)->prepared_statement TSRMLS_CC))->cql;
+    case CASSANDRA_BATCH_STATEMENT:
+      return PHP_CASSANDRA_STATS_BATCH;
+  }
+
+  return NULL;
+}
+
+static void
+php_cassandra_slow_query_append_value(smart_str* out, zval* value TSRMLS_DC)
+{
+  switch (Z_TYPE_P(value)) {
+    case IS_NULL:
+      smart_str_appends(out, "null");
+      break;
+    case IS_BOOL:
+      smart_str_appends(out, Z_BVAL_P(value) ? "true" : "false");
+      break;
+    case IS_LONG:
+      smart_str_append_long(out, Z_LVAL_P(value));
+      break;
+    case IS_STRING:
+      smart_str_appendc(out, '"');
+      smart_str_appendl(out, Z_STRVAL_P(value),
+                        MIN(Z_STRLEN_P(value), PHP_CASSANDRA_SLOW_QUERY_MAX_ARGUMENT));
+      if (Z_STRLEN_P(value) > PHP_CASSANDRA_SLOW_QUERY_MAX_ARGUMENT)
+        smart_str_appends(out, "...");
+      smart_str_appendc(out, '"');
+      break;
+    case IS_OBJECT:
+      if (Z_OBJCE_P(value)->__tostring) {
+        zval copy;
+        copy = *value;
+        zval_copy_ctor(&copy);
+        INIT_PZVAL(&copy);
+        convert_to_string(&copy);
+        smart_str_appendl(out, Z_STRVAL(copy),
+                          MIN(Z_STRLEN(copy), PHP_CASSANDRA_SLOW_QUERY_MAX_ARGUMENT));
+        zval_dtor(&copy);
+      } else {
+        smart_str_appends(out, Z_OBJCE_P(value)->name);
+      }
+      break;
+    default:
+      smart_str_appends(out, zend_zval_type_name(value));
+      break;
+  }
+}
+
+static void
+php_cassandra_slow_query_append_arguments(smart_str* out, zval* arguments TSRMLS_DC)
+{
+  HashPosition pos;
+  zval** current;
+  int first = 1;
+
+  smart_str_appends(out, " arguments=[");
+
+  zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(arguments), &pos);
+  while (zend_hash_get_current_data_ex(Z_ARRVAL_P(arguments), (void**) &current, &pos) == SUCCESS) {
+    if (out->len > PHP_CASSANDRA_SLOW_QUERY_MAX_ARGUMENTS) {
+      smart_str_appends(out, ", ...");
+      break;
+    }
+
+    if (!first)
+      smart_str_appends(out, ", ");
+    first = 0;
+
+    php_cassandra_slow_query_append_value(out, *current TSRMLS_CC);
+    zend_hash_move_forward_ex(Z_ARRVAL_P(arguments), &pos);
+  }
+
+  smart_str_appendc(out, ']');
+}
+
+static void
+php_cassandra_slow_query_log(cassandra_execution_info* info, const char* status,
+                             int keep_context TSRMLS_DC)
+{
+  cass_uint64_t start;
+  cass_uint64_t end;
+  const char* cql;
+  char line[256];
+  smart_str message = { NULL, 0, 0 };
+
+  if (!info || !info->statement)
+    return;
+
+  start = info->bind_start ? info->bind_start : info->submit;
+  end   = info->decode_end ? info->decode_end : uv_hrtime();
+
+  if (end - start < (cass_uint64_t) CASSANDRA_G(slow_query_threshold_ms) * 1000000ULL) {
+    if (!keep_context)
+      php_cassandra_execution_info_clear_context(info);
+    return;
+  }
+
+  cql = php_cassandra_slow_query_cql(info->statement TSRMLS_CC);
+
+  snprintf(line, sizeof(line),
+           "%.3fms status=%s consistency=%s page_size=%ld rows=%lu "
+           "bind=%.3fms wait=%.3fms decode=%.3fms cql=",
+           (end - start) / 1000000.0,
+           status,
+           php_cassandra_consistency_string(info->consistency),
+           info->page_size,
+           (unsigned long) info->row_count,
+           info->bind_end > info->bind_start ? (info->bind_end - info->bind_start) / 1000000.0 : 0.0,
+           info->response > info->submit ? (info->response - info->submit) / 1000000.0 : 0.0,
+           info->decode_end > info->response ? (info->decode_end - info->response) / 1000000.0 : 0.0);
+
+  smart_str_appends(&message, line);
+  smart_str_appends(&message, SAFE_STR(cql));
+
+  if (info->arguments && CASSANDRA_G(slow_query_log_arguments))
+    php_cassandra_slow_query_append_arguments(&message, info->arguments TSRMLS_CC);
+
+  smart_str_0(&message);
+
+  php_cassandra_async_log("SLOW", message.c);
+
+  smart_str_free(&message);
+  php_cassandra_execution_info_clear_context(info);
+}
+
+void
+php_cassandra_slow_query_check(cassandra_execution_info* info TSRMLS_DC)
+{
+  php_cassandra_slow_query_log(info, EG(exception) ? "error" : "ok", 0 TSRMLS_CC);
+}
+
+/* Waiting for an asynchronous result can time out before the threshold is
+ * reached and be retried, so the context is kept until the query is logged. */
+void
+php_cassandra_slow_query_timeout(cassandra_execution_info* info TSRMLS_DC)
+{
+  php_cassandra_slow_query_log(info, "timeout", 1 TSRMLS_CC);
+}
@@ -0,0 +1,7 @@
+#ifndef PHP_CASSANDRA_UTIL_SLOW_QUERY_H
+#define PHP_CASSANDRA_UTIL_SLOW_QUERY_H
+
+void php_cassandra_slow_query_check(cassandra_execution_info* info TSRMLS_DC);
+void php_cassandra_slow_query_timeout(cassandra_execution_info* info TSRMLS_DC);
+
+#endif /* PHP_CASSANDRA_UTIL_SLOW_QUERY_H */
@@ -0,0 +1,432 @@
+#include "php_cassandra.h"
+#include <uv.h>
+#ifndef _WIN32
+#include <errno.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#endif
+#include "util/atomic.h"
+#include "util/metrics.h"
+#include "util/stats.h"
+
+#define PHP_CASSANDRA_STATS_CQL_SIZE 256
+#define PHP_CASSANDRA_STATS_BUCKETS  32
+
+/* Latencies are bucketed by powers of two microseconds, bucket `i` holds
+ * requests that took [2^i, 2^(i+1)) microseconds. Percentiles are reported
+ * as the upper bound of the bucket they fall into.
+ *
+ * The counters of an entry are only updated with atomic operations, since
+ * they are updated by the driver threads of every worker. An entry is
+ * published by setting its hash last, entries with a hash of 0 are free. */
+typedef struct {
+  volatile cass_uint64_t hash;
+  char          cql[PHP_CASSANDRA_STATS_CQL_SIZE];
+  volatile cass_uint64_t calls;
+  volatile cass_uint64_t errors;
+  volatile cass_uint64_t rows;
+  volatile cass_uint64_t total_time;
+  volatile cass_uint64_t min_time;
+  volatile cass_uint64_t max_time;
+  volatile cass_uint64_t buckets[PHP_CASSANDRA_STATS_BUCKETS];
+} php_cassandra_stats_entry;
+
+typedef struct {
+#ifndef _WIN32
+  /* Only taken to insert entries, see php_cassandra_stats_lock() */
+  pthread_mutex_t lock;
+#endif
+  size_t        capacity;
+  volatile cass_uint64_t used;
+  volatile cass_uint64_t dropped;
+  cass_uint64_t last_dump;
+  cassandra_counters counters;
+  php_cassandra_stats_entry entries[1];
+} php_cassandra_stats_table;
+
+typedef struct {
+  php_cassandra_stats_entry* entry;
+  cass_uint64_t              start;
+} php_cassandra_stats_request;
+
+static php_cassandra_stats_table* stats_table = NULL;
+static size_t stats_table_size = 0;
+
+/* The lock is shared by every worker. A worker killed while holding it,
+ * e.g. by pm.max_requests or the OOM killer, leaves it to the next one
+ * instead of blocking all of them. Nothing needs repairing then: an entry
+ * left half written was never published. */
+static void
+php_cassandra_stats_lock()
+{
+#ifndef _WIN32
+#ifdef HAVE_PTHREAD_MUTEXATTR_SETROBUST
+  if (pthread_mutex_lock(&stats_table->lock) == EOWNERDEAD)
+    pthread_mutex_consistent(&stats_table->lock);
+#else
+  pthread_mutex_lock(&stats_table->lock);
+#endif
+#endif
+}
+
+static void
+php_cassandra_stats_unlock()
+{
+#ifndef _WIN32
+  pthread_mutex_unlock(&stats_table->lock);
+#endif
+}
+
+static cass_uint64_t
+php_cassandra_stats_hash(const char* cql, size_t cql_length)
+{
+  /* FNV-1a */
+  cass_uint64_t hash = 14695981039346656037ULL;
+  size_t i;
+
+  for (i = 0; i < cql_length; i++) {
+    hash ^= (unsigned char) cql[i];
+    hash *= 1099511628211ULL;
+  }
+
+  return hash ? hash : 1;
+}
+
+int
+php_cassandra_stats_startup(long size)
+{
+#ifndef _WIN32
+  void* table;
+  pthread_mutexattr_t attributes;
+
+  if (size <= 0)
+    return SUCCESS;
+
+  stats_table_size = sizeof(php_cassandra_stats_table) +
+                     (size - 1) * sizeof(php_cassandra_stats_entry);
+
+  /* The table is mapped before the SAPI forks its workers so that every
+   * worker records into the same memory. */
+  table = mmap(NULL, stats_table_size, PROT_READ | PROT_WRITE,
+               MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+
+  if (table == MAP_FAILED) {
+    stats_table_size = 0;
+    return FAILURE;
+  }
+
+  memset(table, 0, stats_table_size);
+  stats_table = (php_cassandra_stats_table*) table;
+  stats_table->capacity = size;
+
+  pthread_mutexattr_init(&attributes);
+  pthread_mutexattr_setpshared(&attributes, PTHREAD_PROCESS_SHARED);
+#ifdef HAVE_PTHREAD_MUTEXATTR_SETROBUST
+  pthread_mutexattr_setrobust(&attributes, PTHREAD_MUTEX_ROBUST);
+#endif
+  pthread_mutex_init(&stats_table->lock, &attributes);
+  pthread_mutexattr_destroy(&attributes);
+#endif
+
+  return SUCCESS;
+}
+
+void
+php_cassandra_stats_shutdown()
+{
+#ifndef _WIN32
+  if (stats_table) {
+    pthread_mutex_destroy(&stats_table->lock);
+    munmap(stats_table, stats_table_size);
+    stats_table      = NULL;
+    stats_table_size = 0;
+  }
+#endif
+}
+
+int
+php_cassandra_stats_enabled()
+{
+  return stats_table != NULL;
+}
+
+cassandra_counters*
+php_cassandra_stats_counters()
+{
+  return stats_table ? &stats_table->counters : NULL;
+}
+
+/* Finds the entry of a statement without locking. The lock is only taken
+ * when a free slot is reached, to insert the statement. */
+static php_cassandra_stats_entry*
+php_cassandra_stats_find(const char* cql, size_t cql_length)
+{
+  cass_uint64_t hash = php_cassandra_stats_hash(cql, cql_length);
+  size_t length      = MIN(cql_length, PHP_CASSANDRA_STATS_CQL_SIZE - 1);
+  size_t index       = hash % stats_table->capacity;
+  size_t i;
+  int locked         = 0;
+
+  for (i = 0; i < stats_table->capacity; i++) {
+    php_cassandra_stats_entry* entry = &stats_table->entries[index];
+
+    /* Another worker may take the slot before the lock is acquired */
+    if (entry->hash == 0 && !locked) {
+      php_cassandra_stats_lock();
+      locked = 1;
+    }
+
+    if (entry->hash == 0) {
+      entry->min_time = (cass_uint64_t) -1;
+      memcpy(entry->cql, cql, length);
+      entry->cql[length] = '\0';
+      /* Full barrier, the entry is complete before it is visible */
+      PHP_CASSANDRA_ATOMIC_CAS(&entry->hash, 0, hash);
+      PHP_CASSANDRA_ATOMIC_ADD(&stats_table->used, 1);
+      php_cassandra_stats_unlock();
+      return entry;
+    }
+
+    if (entry->hash == hash &&
+        strncmp(entry->cql, cql, length) == 0 && entry->cql[length] == '\0') {
+      if (locked)
+        php_cassandra_stats_unlock();
+      return entry;
+    }
+
+    index = (index + 1) % stats_table->capacity;
+  }
+
+  if (locked)
+    php_cassandra_stats_unlock();
+
+  PHP_CASSANDRA_ATOMIC_ADD(&stats_table->dropped, 1);
+  return NULL;
+}
+
+static void
+php_cassandra_stats_min(volatile cass_uint64_t* min, cass_uint64_t value)
+{
+  cass_uint64_t current = *min;
+
+  while (value < current && !PHP_CASSANDRA_ATOMIC_CAS(min, current, value))
+    current = *min;
+}
+
+static void
+php_cassandra_stats_max(volatile cass_uint64_t* max, cass_uint64_t value)
+{
+  cass_uint64_t current = *max;
+
+  while (value > current && !PHP_CASSANDRA_ATOMIC_CAS(max, current, value))
+    current = *max;
+}
+
+static void
+php_cassandra_stats_callback(CassFuture* future, void* data)
+{
+  php_cassandra_stats_request* request = (php_cassandra_stats_request*) data;
+  php_cassandra_stats_entry* entry     = request->entry;
+  cass_uint64_t elapsed                = uv_hrtime() - request->start;
+  cass_uint64_t micros                 = elapsed / 1000;
+  size_t rows                          = 0;
+  int bucket                           = 0;
+  CassError rc;
+
+  rc = cass_future_error_code(future);
+
+  if (rc == CASS_OK) {
+    const CassResult* result = cass_future_get_result(future);
+    if (result) {
+      rows = cass_result_row_count(result);
+      cass_result_free(result);
+    }
+  }
+
+  while (micros > 1 && bucket < PHP_CASSANDRA_STATS_BUCKETS - 1) {
+    micros >>= 1;
+    bucket++;
+  }
+
+  PHP_CASSANDRA_ATOMIC_ADD(&entry->calls, 1);
+  if (rc != CASS_OK)
+    PHP_CASSANDRA_ATOMIC_ADD(&entry->errors, 1);
+  PHP_CASSANDRA_ATOMIC_ADD(&entry->rows, rows);
+  PHP_CASSANDRA_ATOMIC_ADD(&entry->total_time, elapsed);
+  php_cassandra_stats_min(&entry->min_time, elapsed);
+  php_cassandra_stats_max(&entry->max_time, elapsed);
+  PHP_CASSANDRA_ATOMIC_ADD(&entry->buckets[bucket], 1);
+
+  free(request);
+}
+
+void
+php_cassandra_stats_watch(CassFuture* future, const char* cql, size_t cql_length)
+{
+  php_cassandra_stats_entry* entry;
+  php_cassandra_stats_request* request;
+
+  if (!stats_table)
+    return;
+
+  entry = php_cassandra_stats_find(cql, cql_length);
+
+  if (!entry)
+    return;
+
+  /* The callback runs on a driver thread, so this must not use the
+   * request-bound allocator. */
+  request = (php_cassandra_stats_request*) malloc(sizeof(php_cassandra_stats_request));
+  request->entry = entry;
+  request->start = uv_hrtime();
+
+  if (cass_future_set_callback(future, php_cassandra_stats_callback, request) != CASS_OK)
+    free(request);
+}
+
+static cass_uint64_t
+php_cassandra_stats_percentile(const php_cassandra_stats_entry* entry, double percentile)
+{
+  cass_uint64_t threshold = (cass_uint64_t) ceil(entry->calls * percentile);
+  cass_uint64_t count     = 0;
+  int i;
+
+  for (i = 0; i < PHP_CASSANDRA_STATS_BUCKETS; i++) {
+    count += entry->buckets[i];
+    if (count >= threshold) {
+      cass_uint64_t upper = ((cass_uint64_t) 1 << (i + 1)) * 1000;
+      return MIN(upper, entry->max_time);
+    }
+  }
+
+  return entry->max_time;
+}
+
+static int
+php_cassandra_stats_compare(const void* a, const void* b)
+{
+  const php_cassandra_stats_entry* left  = (const php_cassandra_stats_entry*) a;
+  const php_cassandra_stats_entry* right = (const php_cassandra_stats_entry*) b;
+
+  if (left->total_time == right->total_time)
+    return 0;
+
+  return left->total_time < right->total_time ? 1 : -1;
+}
+
+/* Copies the used entries out of the shared table, ordered by total time. */
+static size_t
+php_cassandra_stats_snapshot(php_cassandra_stats_entry** out)
+{
+  php_cassandra_stats_entry* entries;
+  size_t used  = stats_table->used;
+  size_t count = 0;
+  size_t i;
+
+  /* Entries are never removed, anything added after reading `used` will
+   * simply show up in the next snapshot. The counters are copied without
+   * locking, so a request completing meanwhile may be partly counted. */
+  entries = (php_cassandra_stats_entry*) malloc(MAX(used, 1) *
+                                                sizeof(php_cassandra_stats_entry));
+
+  for (i = 0; i < stats_table->capacity && count < used; i++) {
+    if (stats_table->entries[i].hash != 0 && stats_table->entries[i].calls > 0)
+      memcpy(&entries[count++], (const void*) &stats_table->entries[i],
+             sizeof(php_cassandra_stats_entry));
+  }
+
+  qsort(entries, count, sizeof(php_cassandra_stats_entry), php_cassandra_stats_compare);
+
+  *out = entries;
+  return count;
+}
+
+#define NANOS_TO_SECONDS(value) ((value) / 1000000000.0)
+
+void
+php_cassandra_stats_statements(zval* out TSRMLS_DC)
+{
+  php_cassandra_stats_entry* entries;
+  size_t count;
+  size_t i;
+
+  array_init(out);
+
+  if (!stats_table)
+    return;
+
+  count = php_cassandra_stats_snapshot(&entries);
+
+  for (i = 0; i < count; i++) {
+    php_cassandra_stats_entry* entry = &entries[i];
+    zval* statement;
+
+    MAKE_STD_ZVAL(statement);
+    array_init(statement);
+    add_assoc_string(statement, "cql", entry->cql, 1);
+    add_assoc_long(statement, "calls", entry->calls);
+    add_assoc_long(statement, "errors", entry->errors);
+    add_assoc_long(statement, "rows", entry->rows);
+    add_assoc_double(statement, "total_time", NANOS_TO_SECONDS(entry->total_time));
+    add_assoc_double(statement, "min_time", NANOS_TO_SECONDS(entry->min_time));
+    add_assoc_double(statement, "max_time", NANOS_TO_SECONDS(entry->max_time));
+    add_assoc_double(statement, "mean_time", NANOS_TO_SECONDS(entry->total_time / entry->calls));
+    add_assoc_double(statement, "p99_time", NANOS_TO_SECONDS(php_cassandra_stats_percentile(entry, 0.99)));
+    add_next_index_zval(out, statement);
+  }
+
+  free(entries);
+}
+
+void
+php_cassandra_stats_dump(long interval, long top)
+{
+  php_cassandra_stats_entry* entries;
+  cass_uint64_t now;
+  cass_uint64_t last_dump;
+  size_t count;
+  size_t i;
+  char line[PHP_CASSANDRA_STATS_CQL_SIZE + 256];
+
+  if (!stats_table || interval <= 0 || top <= 0)
+    return;
+
+  now       = uv_hrtime();
+  last_dump = stats_table->last_dump;
+
+  if (last_dump == 0) {
+    /* Start the clock on the first request instead of dumping right away. */
+    PHP_CASSANDRA_ATOMIC_CAS(&stats_table->last_dump, 0, now);
+    return;
+  }
+
+  if (now - last_dump < (cass_uint64_t) interval * 1000000000ULL)
+    return;
+
+  /* Only one worker gets to dump per interval. */
+  if (!PHP_CASSANDRA_ATOMIC_CAS(&stats_table->last_dump, last_dump, now))
+    return;
+
+  count = php_cassandra_stats_snapshot(&entries);
+
+  for (i = 0; i < count && i < (size_t) top; i++) {
+    php_cassandra_stats_entry* entry = &entries[i];
+
+    snprintf(line, sizeof(line),
+             "#%u calls=%llu errors=%llu rows=%llu total=%.3fms "
+             "mean=%.3fms min=%.3fms max=%.3fms p99=%.3fms cql=%s",
+             (unsigned int) (i + 1),
+             (unsigned long long) entry->calls,
+             (unsigned long long) entry->errors,
+             (unsigned long long) entry->rows,
+             entry->total_time / 1000000.0,
+             entry->total_time / entry->calls / 1000000.0,
+             entry->min_time / 1000000.0,
+             entry->max_time / 1000000.0,
+             php_cassandra_stats_percentile(entry, 0.99) / 1000000.0,
+             entry->cql);
+    php_cassandra_log_line("STATS", line);
+  }
+
+  free(entries);
+}
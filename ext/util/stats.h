@@ -0,0 +1,14 @@
+#ifndef PHP_CASSANDRA_UTIL_STATS_H
+#define PHP_CASSANDRA_UTIL_STATS_H
+
+#define PHP_CASSANDRA_STATS_BATCH "<batch>"
+
+int  php_cassandra_stats_startup(long size);
+void php_cassandra_stats_shutdown();
+int  php_cassandra_stats_enabled();
+cassandra_counters* php_cassandra_stats_counters();
+void php_cassandra_stats_watch(CassFuture* future, const char* cql, size_t cql_length);
+void php_cassandra_stats_statements(zval* out TSRMLS_DC);
+void php_cassandra_stats_dump(long interval, long top);
+
+#endif /* PHP_CASSANDRA_UTIL_STATS_H */
@@ -149,12 +149,48 @@ php_cassandra_type_scalar(CassValueType type TSRMLS_DC)
 }
 #undef TYPE_CODE
 
+/* Composite types are interned for the duration of the request so that
+ * equal types are represented by the same object. */
+static zval*
+php_cassandra_type_lookup(const char* key, int key_len TSRMLS_DC)
+{
+  zval** ztype;
+
+  if (CASSANDRA_G(type_registry) &&
+      zend_hash_find(CASSANDRA_G(type_registry), key, key_len,
+                     (void**) &ztype) == SUCCESS) {
+    Z_ADDREF_PP(ztype);
+    return *ztype;
+  }
+
+  return NULL;
+}
+
+static void
+php_cassandra_type_register(const char* key, int key_len, zval* ztype TSRMLS_DC)
+{
+  if (CASSANDRA_G(type_registry) == NULL) {
+    ALLOC_HASHTABLE(CASSANDRA_G(type_registry));
+    zend_hash_init(CASSANDRA_G(type_registry), 0, NULL, ZVAL_PTR_DTOR, 0);
+  }
+
+  Z_ADDREF_P(ztype);
+  zend_hash_update(CASSANDRA_G(type_registry), key, key_len,
+                   &ztype, sizeof(zval*), NULL);
+}
+
 zval*
 php_cassandra_type_map(CassValueType key_type,
                        CassValueType value_type TSRMLS_DC)
 {
   zval* ztype;
   cassandra_type_map* map;
+  char key[32];
+  int key_len;
+
+  key_len = slprintf(key, sizeof(key), "map<%d,%d>", key_type, value_type);
+  if ((ztype = php_cassandra_type_lookup(key, key_len TSRMLS_CC)) != NULL)
+    return ztype;
 
   MAKE_STD_ZVAL(ztype);
   object_init_ex(ztype, cassandra_type_map_ce);
@@ -162,6 +198,8 @@ php_cassandra_type_map(CassValueType key_type,
   map->key_type   = key_type;
   map->value_type = value_type;
 
+  php_cassandra_type_register(key, key_len, ztype TSRMLS_CC);
+
   return ztype;
 }
 
@@ -170,12 +208,20 @@ php_cassandra_type_set(CassValueType type TSRMLS_DC)
 {
   zval* ztype;
   cassandra_type_set* set;
+  char key[32];
+  int key_len;
+
+  key_len = slprintf(key, sizeof(key), "set<%d>", type);
+  if ((ztype = php_cassandra_type_lookup(key, key_len TSRMLS_CC)) != NULL)
+    return ztype;
 
   MAKE_STD_ZVAL(ztype);
   object_init_ex(ztype, cassandra_type_set_ce);
   set = (cassandra_type_set*) zend_object_store_get_object(ztype TSRMLS_CC);
   set->type = type;
 
+  php_cassandra_type_register(key, key_len, ztype TSRMLS_CC);
+
   return ztype;
 }
 
@@ -184,12 +230,20 @@ php_cassandra_type_collection(CassValueType type TSRMLS_DC)
 {
   zval* ztype;
   cassandra_type_collection* collection;
+  char key[32];
+  int key_len;
+
+  key_len = slprintf(key, sizeof(key), "list<%d>", type);
+  if ((ztype = php_cassandra_type_lookup(key, key_len TSRMLS_CC)) != NULL)
+    return ztype;
 
   MAKE_STD_ZVAL(ztype);
   object_init_ex(ztype, cassandra_type_collection_ce);
   collection = (cassandra_type_collection*) zend_object_store_get_object(ztype TSRMLS_CC);
   collection->type = type;
 
+  php_cassandra_type_register(key, key_len, ztype TSRMLS_CC);
+
   return ztype;
 }
 
@@ -198,15 +252,37 @@ php_cassandra_type_custom(char* name TSRMLS_DC)
 {
   zval* ztype;
   cassandra_type_custom* custom;
+  char* key;
+  int key_len;
+
+  key_len = spprintf(&key, 0, "custom<%s>", name);
+  if ((ztype = php_cassandra_type_lookup(key, key_len TSRMLS_CC)) != NULL) {
+    efree(key);
+    efree(name);
+    return ztype;
+  }
 
   MAKE_STD_ZVAL(ztype);
   object_init_ex(ztype, cassandra_type_custom_ce);
   custom = (cassandra_type_custom*) zend_object_store_get_object(ztype TSRMLS_CC);
   custom->name = name;
 
+  php_cassandra_type_register(key, key_len, ztype TSRMLS_CC);
+  efree(key);
+
   return ztype;
 }
 
+void
+php_cassandra_type_registry_destroy(TSRMLS_D)
+{
+  if (CASSANDRA_G(type_registry)) {
+    zend_hash_destroy(CASSANDRA_G(type_registry));
+    FREE_HASHTABLE(CASSANDRA_G(type_registry));
+    CASSANDRA_G(type_registry) = NULL;
+  }
+}
+
 #define EXPECTING_TOKEN(expected) \
   zend_throw_exception_ex(cassandra_invalid_argument_exception_ce, 0 TSRMLS_CC, \
     "Unexpected %s at position %d in string \"%s\", expected " expected, \
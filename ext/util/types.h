@@ -26,6 +26,7 @@ zval* php_cassandra_type_collection(CassValueType type TSRMLS_DC);
 zval* php_cassandra_type_map(CassValueType key_type,
                              CassValueType value_type TSRMLS_DC);
 zval* php_cassandra_type_custom(char* name TSRMLS_DC);
+void php_cassandra_type_registry_destroy(TSRMLS_D);
 int php_cassandra_parse_column_type(const char* validator,
                                     size_t      validator_len,
                                     int*        reversed_out,
@@ -1,5 +1,6 @@
 #include "php_cassandra.h"
 #include <stdlib.h>
+#include "util/fork.h"
 #include "util/uuid_gen.h"
 
 ZEND_EXTERN_MODULE_GLOBALS(cassandra)
@@ -7,17 +8,20 @@ ZEND_EXTERN_MODULE_GLOBALS(cassandra)
 void
 php_cassandra_uuid_generate_random(CassUuid* out TSRMLS_DC)
 {
+  php_cassandra_fork_check(TSRMLS_C);
   cass_uuid_gen_random(CASSANDRA_G(uuid_gen), out);
 }
 
 void
 php_cassandra_uuid_generate_time(CassUuid* out TSRMLS_DC)
 {
+  php_cassandra_fork_check(TSRMLS_C);
   cass_uuid_gen_time(CASSANDRA_G(uuid_gen), out);
 }
 
 void
 php_cassandra_uuid_generate_from_time(long timestamp, CassUuid* out TSRMLS_DC)
 {
+  php_cassandra_fork_check(TSRMLS_C);
   cass_uuid_gen_from_time(CASSANDRA_G(uuid_gen), (cass_uint64_t) timestamp, out);
 }
@@ -248,6 +248,14 @@ class FeatureContext implements Context, SnippetAcceptingContext
         }
     }
 
+    /**
+     * @Then the response should contain:
+     */
+    public function theResponseShouldContain(PyStringNode $string)
+    {
+        PHPUnit_Framework_Assert::assertContains((string) $string, $this->lastResponse);
+    }
+
     /**
      * @When I go to :path :count times
      */
@@ -349,6 +357,7 @@ class FeatureContext implements Context, SnippetAcceptingContext
 
     /**
      * @Given the following logger settings:
+     * @Given the following ini settings:
      */
     public function theFollowingLoggerSettings(PyStringNode $string)
     {
@@ -22,3 +22,66 @@ Feature: Logging
     When it is executed
     Then a log file "feature-logging.log" should exist
     And the log file "feature-logging.log" should contain "TRACE"
+
+  Scenario: Slow queries are logged
+    Given the following logger settings:
+      """ini
+      cassandra.log=feature-slow-queries.log
+      cassandra.slow_query_threshold_ms=1
+      """
+    And the following example:
+      """php
+      <?php
+      $cluster   = Cassandra::cluster()
+                     ->withContactPoints('127.0.0.1')
+                     ->build();
+      $session   = $cluster->connect();
+      $statement = new Cassandra\SimpleStatement("SELECT * FROM system.local");
+
+      $future = $session->executeAsync($statement);
+      usleep(10000);
+      $future->get();
+      echo "Executed\n";
+      """
+    When it is executed
+    Then its output should contain:
+      """
+      Executed
+      """
+    And the log file "feature-slow-queries.log" should contain "status=ok"
+    And the log file "feature-slow-queries.log" should contain "cql=SELECT * FROM system.local"
+
+  Scenario: Asynchronous requests that time out are logged as slow queries
+    Given the following logger settings:
+      """ini
+      cassandra.log=feature-slow-timeouts.log
+      cassandra.slow_query_threshold_ms=1
+      """
+    And the following example:
+      """php
+      <?php
+      $cluster   = Cassandra::cluster()
+                     ->withContactPoints('127.0.0.1')
+                     ->build();
+      $session   = $cluster->connect();
+      $statement = new Cassandra\SimpleStatement("SELECT * FROM system.schema_columns");
+
+      // queued behind many others so that it can't be answered right away
+      for ($i = 0; $i < 1000; $i++) {
+          $future = $session->executeAsync($statement);
+      }
+      usleep(2000);
+
+      try {
+          $future->get(0.000001);
+      } catch (Cassandra\Exception\TimeoutException $e) {
+          echo "Timed out\n";
+      }
+      """
+    When it is executed
+    Then its output should contain:
+      """
+      Timed out
+      """
+    And the log file "feature-slow-timeouts.log" should contain "status=timeout"
+    And the log file "feature-slow-timeouts.log" should contain "cql=SELECT * FROM system.schema_columns"
@@ -20,6 +20,7 @@ Feature: Prepared Statements
         song_id uuid,
         PRIMARY KEY (id, title, album, artist)
       );
+      CREATE TABLE accounts ("userId" int PRIMARY KEY, userid int, name text);
       """
 
   Scenario: Prepared statements support named arguments
@@ -81,3 +82,208 @@ Feature: Prepared Statements
       """
       Mick Jager: Memo From Turner / Performance
       """
+
+  Scenario: Named arguments bind every parameter with the same name
+    Given the following example:
+      """php
+      <?php
+      $cluster   = Cassandra::cluster()
+                     ->withContactPoints('127.0.0.1')
+                     ->build();
+      $session   = $cluster->connect("simplex");
+      $insert    = $session->prepare(
+                     "INSERT INTO accounts (\"userId\", userid, name) VALUES (:id, :id, :name)"
+                   );
+
+      $session->execute($insert, new Cassandra\ExecutionOptions(array(
+          'arguments' => array('id' => 7, 'name' => 'sue')
+      )));
+
+      $rows = $session->execute(new Cassandra\SimpleStatement("SELECT * FROM accounts"));
+      echo "userId: " . $rows[0]['userId'] . ", userid: " . $rows[0]['userid'] . "\n";
+      """
+    When it is executed
+    Then its output should contain:
+      """
+      userId: 7, userid: 7
+      """
+
+  Scenario: Named arguments follow the case rules of CQL identifiers
+    Given the following example:
+      """php
+      <?php
+      $cluster   = Cassandra::cluster()
+                     ->withContactPoints('127.0.0.1')
+                     ->build();
+      $session   = $cluster->connect("simplex");
+      $insert    = $session->prepare(
+                     "INSERT INTO accounts (\"userId\", userid, name) VALUES (?, ?, ?)"
+                   );
+
+      $session->execute($insert, new Cassandra\ExecutionOptions(array(
+          'arguments' => array('"userId"' => 1, 'USERID' => 2, 'Name' => 'sue')
+      )));
+
+      $rows = $session->execute(new Cassandra\SimpleStatement("SELECT * FROM accounts"));
+      echo "userId: " . $rows[0]['userId'] . ", userid: " . $rows[0]['userid'] .
+           ", name: " . $rows[0]['name'] . "\n";
+      """
+    When it is executed
+    Then its output should contain:
+      """
+      userId: 1, userid: 2, name: sue
+      """
+
+  Scenario: Named arguments that match no parameter are rejected
+    Given the following example:
+      """php
+      <?php
+      $cluster   = Cassandra::cluster()
+                     ->withContactPoints('127.0.0.1')
+                     ->build();
+      $session   = $cluster->connect("simplex");
+      $insert    = $session->prepare(
+                     "INSERT INTO accounts (\"userId\", userid, name) VALUES (?, ?, ?)"
+                   );
+
+      $names = array('nickname', '"Name"');
+      foreach ($names as $name) {
+          try {
+              $session->execute($insert, new Cassandra\ExecutionOptions(array(
+                  'arguments' => array('"userId"' => 1, 'userid' => 2, $name => 'sue')
+              )));
+          } catch (Cassandra\Exception\InvalidArgumentException $e) {
+              echo get_class($e) . ": " . $e->getMessage() . "\n";
+          }
+      }
+      """
+    When it is executed
+    Then its output should contain:
+      """
+      Cassandra\Exception\InvalidArgumentException: Unknown parameter "nickname"
+      Cassandra\Exception\InvalidArgumentException: Unknown parameter ""Name""
+      """
+
+  Scenario: Strings with embedded NUL bytes are bound in full
+    Given the following example:
+      """php
+      <?php
+      $cluster   = Cassandra::cluster()
+                     ->withContactPoints('127.0.0.1')
+                     ->build();
+      $session   = $cluster->connect("simplex");
+      $insert    = $session->prepare(
+                     "INSERT INTO accounts (\"userId\", userid, name) VALUES (?, ?, ?)"
+                   );
+
+      $session->execute($insert, new Cassandra\ExecutionOptions(array(
+          'arguments' => array(1, 1, "by\0index")
+      )));
+      $session->execute($insert, new Cassandra\ExecutionOptions(array(
+          'arguments' => array('"userId"' => 2, 'userid' => 2, 'name' => "by\0name")
+      )));
+
+      $select = $session->prepare("SELECT name FROM accounts WHERE \"userId\" = ?");
+      foreach (array(1, 2) as $id) {
+          $rows = $session->execute($select, new Cassandra\ExecutionOptions(array(
+              'arguments' => array($id)
+          )));
+          echo $id . ": " . strlen($rows[0]['name']) . " bytes, " . bin2hex($rows[0]['name']) . "\n";
+      }
+      """
+    When it is executed
+    Then its output should contain:
+      """
+      1: 8 bytes, 627900696e646578
+      2: 7 bytes, 6279006e616d65
+      """
+
+  Scenario: Bound statements keep their values between executions
+    Given the following example:
+      """php
+      <?php
+      $cluster   = Cassandra::cluster()
+                     ->withContactPoints('127.0.0.1')
+                     ->build();
+      $session   = $cluster->connect("simplex");
+      $insert    = new Cassandra\BoundStatement(
+                     $session->prepare(
+                       "INSERT INTO playlists (id, song_id, artist, title, album) " .
+                       "VALUES (62c36092-82a1-3a00-93d1-46196ee77204, ?, ?, ?, ?)"
+                     ),
+                     array(
+                       'song_id' => new Cassandra\Uuid('756716f7-2e54-4715-9f00-91dcbea6cf50'),
+                       'artist'  => 'Joséphine Baker',
+                       'album'   => 'Bye Bye Blackbird'
+                     )
+                   );
+
+      $titles = array('La Petite Tonkinoise', 'Haiti', 'Sous le ciel d\'Afrique');
+
+      foreach ($titles as $title) {
+          $session->execute($insert->bind('title', $title));
+      }
+
+      $statement = new Cassandra\SimpleStatement("SELECT * FROM simplex.playlists");
+      $result    = $session->execute($statement);
+
+      foreach ($result as $row) {
+        echo $row['artist'] . ": " . $row['title'] . " / " . $row['album'] . "\n";
+      }
+      """
+    When it is executed
+    Then its output should contain:
+      """
+      Joséphine Baker: La Petite Tonkinoise / Bye Bye Blackbird
+      """
+    And its output should contain:
+      """
+      Joséphine Baker: Haiti / Bye Bye Blackbird
+      """
+    And its output should contain:
+      """
+      Joséphine Baker: Sous le ciel d'Afrique / Bye Bye Blackbird
+      """
+
+  Scenario: Bound statements rebuilt for another page keep the last value of each parameter
+    Given the following example:
+      """php
+      <?php
+      $cluster   = Cassandra::cluster()
+                     ->withContactPoints('127.0.0.1')
+                     ->build();
+      $session   = $cluster->connect("simplex");
+      $id        = new Cassandra\Uuid('62c36092-82a1-3a00-93d1-46196ee77204');
+
+      foreach (array('A', 'B', 'C') as $title) {
+          $session->execute(new Cassandra\SimpleStatement(
+              "INSERT INTO playlists (id, title, album, artist) VALUES (?, ?, 'album', 'artist')"
+          ), new Cassandra\ExecutionOptions(array('arguments' => array($id, $title))));
+      }
+
+      $select = new Cassandra\BoundStatement(
+                  $session->prepare(
+                    "SELECT title FROM playlists WHERE id = :id AND title >= :title"
+                  ),
+                  array('id' => $id)
+                );
+      $select->bind('title', 'C');
+      $select->bind(1, 'A');
+      $select->bind('TITLE', 'B');
+
+      $options = new Cassandra\ExecutionOptions(array('page_size' => 1));
+
+      // The first result keeps the driver statement for its next page, so
+      // the second execution binds a new one with the remembered values.
+      $first  = $session->execute($select, $options);
+      $second = $session->execute($select, $options);
+
+      echo "First: " . $first[0]['title'] . "\n";
+      echo "Second: " . $second[0]['title'] . "\n";
+      """
+    When it is executed
+    Then its output should contain:
+      """
+      First: B
+      Second: B
+      """
@@ -0,0 +1,112 @@
+Feature: Rate limiting
+
+  PHP Driver can limit the number of requests and request bytes sent per
+  second using `Cassandra\Cluster\Builder::withRateLimit()`. In fail-fast mode
+  requests over the limit throw a `Cassandra\Exception\RuntimeException`
+  instead of waiting.
+
+  Background:
+    Given a running Cassandra cluster
+
+  Scenario: Requests over the limit fail fast
+    Given the following example:
+      """php
+      <?php
+      $cluster   = Cassandra::cluster()
+                     ->withContactPoints('127.0.0.1')
+                     ->withRateLimit(1, null, true)
+                     ->build();
+      $session   = $cluster->connect("system");
+      $statement = new Cassandra\SimpleStatement("SELECT key FROM local");
+
+      for ($i = 0; $i < 2; $i++) {
+          try {
+              $rows = $session->execute($statement);
+              echo "sent: " . $rows[0]['key'] . "\n";
+          } catch (Cassandra\Exception\RuntimeException $e) {
+              echo "rejected: " . $e->getMessage() . "\n";
+          }
+      }
+      """
+    When it is executed
+    Then its output should contain:
+      """
+      sent: local
+      rejected: Rate limit of 1 requests per second exceeded
+      """
+
+  Scenario: Rejected requests do not use up the bytes limit
+    Given the following example:
+      """php
+      <?php
+      $cluster   = Cassandra::cluster()
+                     ->withContactPoints('127.0.0.1')
+                     ->withRateLimit(1, 100, true)
+                     ->build();
+      $session   = $cluster->connect("system");
+      $statement = new Cassandra\SimpleStatement("SELECT key FROM local");
+
+      $session->execute($statement);
+
+      for ($i = 0; $i < 5; $i++) {
+          try {
+              $session->execute($statement);
+          } catch (Cassandra\Exception\RuntimeException $e) {
+              echo $e->getMessage() . "\n";
+          }
+      }
+      """
+    When it is executed
+    Then its output should contain:
+      """
+      Rate limit of 1 requests per second exceeded
+      Rate limit of 1 requests per second exceeded
+      Rate limit of 1 requests per second exceeded
+      Rate limit of 1 requests per second exceeded
+      Rate limit of 1 requests per second exceeded
+      """
+
+  @cassandra-version-2.0
+  Scenario: Fetching the next page is rate limited
+    Given the following schema:
+      """cql
+      CREATE KEYSPACE simplex WITH replication = {
+        'class': 'SimpleStrategy',
+        'replication_factor': 1
+      };
+      USE simplex;
+      CREATE TABLE entries (key text PRIMARY KEY, value int);
+      INSERT INTO entries (key, value) VALUES ('a', 0);
+      INSERT INTO entries (key, value) VALUES ('b', 1);
+      INSERT INTO entries (key, value) VALUES ('c', 2);
+      """
+    And the following example:
+      """php
+      <?php
+      $cluster   = Cassandra::cluster()
+                     ->withContactPoints('127.0.0.1')
+                     ->withRateLimit(1, null, true)
+                     ->build();
+      $session   = $cluster->connect("simplex");
+      $statement = new Cassandra\SimpleStatement("SELECT * FROM entries");
+      $options   = new Cassandra\ExecutionOptions(array('page_size' => 1));
+      $rows      = $session->execute($statement, $options);
+
+      try {
+          $rows->nextPage();
+      } catch (Cassandra\Exception\RuntimeException $e) {
+          echo "nextPage: " . $e->getMessage() . "\n";
+      }
+
+      try {
+          $rows->nextPageAsync();
+      } catch (Cassandra\Exception\RuntimeException $e) {
+          echo "nextPageAsync: " . $e->getMessage() . "\n";
+      }
+      """
+    When it is executed
+    Then its output should contain:
+      """
+      nextPage: Rate limit of 1 requests per second exceeded
+      nextPageAsync: Rate limit of 1 requests per second exceeded
+      """
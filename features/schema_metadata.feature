@@ -251,3 +251,35 @@ Feature: Schema Metadata
       varchar_value: varchar
       varint_value: varint
       """
+
+    Scenario: Schema snapshots are versioned
+    Given the following example:
+      """php
+      <?php
+      $cluster   = Cassandra::cluster()
+                         ->withContactPoints('127.0.0.1')
+                         ->build();
+      $session   = $cluster->connect("simplex");
+      $version   = $session->schemaVersion();
+
+      echo "Unchanged: " . var_export($version === $session->schemaVersion(), true) . "\n";
+
+      $session->execute(new Cassandra\SimpleStatement(
+          "CREATE TABLE simplex.versioned (id int PRIMARY KEY)"
+      ));
+
+      // The driver refreshes its metadata in the background
+      for ($i = 0; $i < 50 && $version === $session->schemaVersion(); $i++) {
+          usleep(100000);
+      }
+
+      echo "Changed: " . var_export($version !== $session->schemaVersion(), true) . "\n";
+      echo "Has table: " . var_export($session->schema()->keyspace("simplex")->table("versioned") !== null, true) . "\n";
+      """
+    When it is executed
+    Then its output should contain:
+      """
+      Unchanged: true
+      Changed: true
+      Has table: true
+      """
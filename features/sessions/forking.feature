@@ -0,0 +1,85 @@
+Feature: Forking
+
+  PHP Driver can be used by processes that fork, like the workers of php-fpm.
+
+  Background:
+    Given a running Cassandra cluster
+
+  Scenario: Forked processes generate their own UUIDs
+    Given the following example:
+      """php
+      <?php
+      $warmup  = new Cassandra\Uuid();
+      $sockets = stream_socket_pair(STREAM_PF_UNIX, STREAM_SOCK_STREAM, STREAM_IPPROTO_IP);
+      $pid     = pcntl_fork();
+
+      if ($pid == 0) {
+          fwrite($sockets[1], (string) new Cassandra\Uuid());
+          exit(0);
+      }
+
+      $uuid  = (string) new Cassandra\Uuid();
+      $child = stream_get_contents($sockets[0], 36);
+      pcntl_waitpid($pid, $status);
+
+      echo "Different: " . var_export($uuid !== $child, true) . "\n";
+      """
+    When it is executed
+    Then its output should contain:
+      """
+      Different: true
+      """
+
+  Scenario: Commands can be run while a persistent session is connected
+    Given the following example:
+      """php
+      <?php
+      $cluster = Cassandra::cluster()
+                     ->withContactPoints('127.0.0.1')
+                     ->withPersistentSessions(true)
+                     ->build();
+      $session = $cluster->connect("system");
+
+      for ($i = 0; $i < 20; $i++) {
+          $output = shell_exec("echo command");
+      }
+      echo trim($output) . "\n";
+
+      $rows = $session->execute(new Cassandra\SimpleStatement("SELECT key FROM local"));
+      echo $rows[0]['key'] . "\n";
+      """
+    When it is executed
+    Then its output should contain:
+      """
+      command
+      local
+      """
+
+  Scenario: Forked processes connect their own persistent sessions
+    Given the following example:
+      """php
+      <?php
+      $cluster = Cassandra::cluster()
+                     ->withContactPoints('127.0.0.1')
+                     ->withPersistentSessions(true)
+                     ->build();
+      $cluster->connect("system");
+
+      $pid = pcntl_fork();
+
+      if ($pid == 0) {
+          $session = $cluster->connect("system");
+          $rows    = $session->execute(new Cassandra\SimpleStatement("SELECT key FROM local"));
+          echo "child: " . $rows[0]['key'] . "\n";
+          exit(0);
+      }
+
+      pcntl_waitpid($pid, $status);
+      echo "parent: done\n";
+      """
+    When it is executed
+    Then its output should contain:
+      """
+      child: local
+      parent: done
+      """
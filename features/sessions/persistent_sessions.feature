@@ -63,6 +63,40 @@ Feature: Persistent Sessions
       | Persistent Clusters | 1 |
       | Persistent Sessions | 2 |
 
+  Scenario: Persistent sessions keep the keyspace they were connected to
+    Given the following example:
+      """php
+      <?php
+
+      $cluster = Cassandra::cluster()
+                         ->withContactPoints('127.0.0.1')
+                         ->withPersistentSessions(true)
+                         ->build();
+      $system  = $cluster->connect("system");
+      $default = $cluster->connect();
+      $query   = new Cassandra\SimpleStatement("SELECT key FROM local");
+
+      $rows = $system->execute($query);
+      echo "system: " . $rows[0]['key'] . "\n";
+
+      try {
+          $default->execute($query);
+          echo "default: no keyspace expected\n";
+      } catch (Cassandra\Exception\InvalidQueryException $e) {
+          echo "default: no keyspace\n";
+      }
+
+      $rows = $system->execute($query);
+      echo "system: " . $rows[0]['key'] . "\n";
+      """
+    When it is executed
+    Then its output should contain:
+      """
+      system: local
+      default: no keyspace
+      system: local
+      """
+
   Scenario: Non-persistent sessions are recreated for each request
     Given a file named "connect.php" with:
       """php
@@ -79,3 +113,58 @@ Feature: Persistent Sessions
     Then I should see:
       | Persistent Clusters | 0 |
       | Persistent Sessions | 0 |
+
+  Scenario: Persistent sessions that failed to connect fail fast and are rebuilt
+    Given the following schema:
+      """cql
+      CREATE KEYSPACE simplex WITH replication = {
+        'class': 'SimpleStrategy',
+        'replication_factor': 1
+      };
+      """
+    And a file named "connect.php" with:
+      """php
+      <?php
+
+      $cluster = Cassandra::cluster()
+                         ->withContactPoints('127.0.0.1')
+                         ->withPersistentSessions(true)
+                         ->build();
+      $start = microtime(true);
+      try {
+          $session = $cluster->connect("rebuilt");
+          $rows    = $session->execute(new Cassandra\SimpleStatement("SELECT key FROM system.local"));
+          echo "connected: " . $rows[0]['key'] . "\n";
+      } catch (Cassandra\Exception $e) {
+          echo "failed, fast: " . var_export(microtime(true) - $start < 1, true) . "\n";
+      }
+      """
+    And a file named "create.php" with:
+      """php
+      <?php
+
+      $cluster = Cassandra::cluster()
+                         ->withContactPoints('127.0.0.1')
+                         ->build();
+      $session = $cluster->connect();
+      $session->execute(new Cassandra\SimpleStatement(
+          "CREATE KEYSPACE rebuilt WITH replication = " .
+          "{'class': 'SimpleStrategy', 'replication_factor': 1}"
+      ));
+      echo "created\n";
+      """
+    When I go to "/connect.php"
+    And I go to "/connect.php"
+    Then the response should contain:
+      """
+      failed, fast: true
+      """
+    When I go to "/create.php"
+    And I go to "/connect.php" 5 times
+    Then the response should contain:
+      """
+      connected: local
+      """
+    When I go to "/status.php"
+    Then I should see:
+      | Persistent Sessions | 1 |
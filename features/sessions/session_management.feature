@@ -87,3 +87,29 @@ Feature: Session management
       """
       Result contains 3 rows
       """
+
+  Scenario: Sessions declared in php.ini are retrieved by name
+    Given the following ini settings:
+      """ini
+      cassandra.sessions="local=127.0.0.1/system?core_connections=1&max_connections=2"
+      """
+    And the following example:
+      """php
+      <?php
+      $session = Cassandra::session('local');
+      $rows    = $session->execute(new Cassandra\SimpleStatement("SELECT key FROM local"));
+
+      echo "Connected to " . $rows->first()['key'] . "\n";
+
+      try {
+          Cassandra::session('missing');
+      } catch (Cassandra\Exception\InvalidArgumentException $e) {
+          echo get_class($e) . "\n";
+      }
+      """
+    When it is executed
+    Then its output should contain:
+      """
+      Connected to local
+      Cassandra\Exception\InvalidArgumentException
+      """
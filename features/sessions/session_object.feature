@@ -95,3 +95,92 @@ Feature: Session Object
       German session contains 1 rows
       UK session contains 1 rows
       """
+
+  Scenario: Sessions expose driver metrics
+    Given the following example:
+      """php
+      <?php
+      $cluster = Cassandra::cluster()
+                   ->withContactPoints('127.0.0.1')
+                   ->build();
+      $session = $cluster->connect("system");
+      $session->execute(new Cassandra\SimpleStatement("SELECT * FROM local"));
+
+      $metrics = $session->metrics();
+      echo "Sections: " . implode(", ", array_keys($metrics)) . "\n";
+      echo "Has connections: " . ($metrics['stats']['total_connections'] > 0 ? "yes" : "no");
+      """
+    When it is executed
+    Then its output should contain:
+      """
+      Sections: requests, stats, errors
+      Has connections: yes
+      """
+
+  Scenario: Metrics can be exported in the OpenMetrics text format
+    Given the following example:
+      """php
+      <?php
+      $cluster = Cassandra::cluster()
+                   ->withContactPoints('127.0.0.1')
+                   ->withPersistentSessions(true)
+                   ->build();
+      $session = $cluster->connect();
+      $session->execute(new Cassandra\SimpleStatement("SELECT * FROM system.local"));
+
+      $text = Cassandra\Metrics::export();
+      foreach (explode("\n", $text) as $line) {
+          if (strpos($line, "cassandra_requests_total") === 0 ||
+              strpos($line, "cassandra_session_connections{session=\"0\"") === 0 ||
+              $line === "# EOF") {
+              echo preg_replace('/ [0-9.e+-]+$/', '', $line) . "\n";
+          }
+      }
+      """
+    When it is executed
+    Then its output should contain:
+      """
+      cassandra_requests_total
+      cassandra_session_connections{session="0",keyspace="",state="total"}
+      cassandra_session_connections{session="0",keyspace="",state="available"}
+      # EOF
+      """
+
+  Scenario: Decoding metrics are only counted when enabled
+    Given the following ini settings:
+      """ini
+      cassandra.metrics=1
+      """
+    And the following example:
+      """php
+      <?php
+      $cluster = Cassandra::cluster()
+                   ->withContactPoints('127.0.0.1')
+                   ->build();
+      $session = $cluster->connect();
+      $session->execute(new Cassandra\SimpleStatement("SELECT * FROM system.local"));
+
+      foreach (explode("\n", Cassandra\Metrics::export()) as $line) {
+          if (strpos($line, "cassandra_decoded_rows_total") === 0 ||
+              strpos($line, "cassandra_request_errors_total") === 0) {
+              echo $line . "\n";
+          }
+      }
+
+      try {
+          $session->execute(new Cassandra\SimpleStatement("SELECT * FROM system.unknown"));
+      } catch (Cassandra\Exception $e) {}
+
+      foreach (explode("\n", Cassandra\Metrics::export()) as $line) {
+          if (strpos($line, "cassandra_request_errors_total") === 0) {
+              echo $line . "\n";
+          }
+      }
+      """
+    When it is executed
+    Then its output should contain:
+      """
+      cassandra_decoded_rows_total 1
+      cassandra_request_errors_total 0
+      cassandra_request_errors_total 1
+      """
@@ -19,6 +19,12 @@ Feature: Simple Statements
         song_id uuid,
         PRIMARY KEY (id, title, album, artist)
       );
+      CREATE TABLE albums (
+        id int PRIMARY KEY,
+        tracks list<varchar>,
+        genres set<varchar>,
+        ratings map<varchar, int>
+      );
       """
 
   Scenario: Simple statements are initialized with a CQL string
@@ -99,3 +105,230 @@ Feature: Simple Statements
       """
       Mick Jager: Memo From Turner / Performance
       """
+
+  Scenario: Rows can be iterated in nested loops but not by reference
+    Given the following example:
+      """php
+      <?php
+      $cluster   = Cassandra::cluster()
+                     ->withContactPoints('127.0.0.1')
+                     ->build();
+      $session   = $cluster->connect("system");
+      $statement = new Cassandra\SimpleStatement("SELECT keyspace_name FROM schema_keyspaces");
+      $rows      = $session->execute($statement);
+
+      $pairs = 0;
+      foreach ($rows as $i => $outer) {
+          foreach ($rows as $j => $inner) {
+              if ($outer === $rows[$i] && $inner === $rows[$j])
+                  $pairs++;
+          }
+      }
+      echo "Pairs: " . var_export($pairs === count($rows) * count($rows), true) . "\n";
+
+      try {
+          foreach ($rows as &$row) {
+          }
+      } catch (Cassandra\Exception\LogicException $e) {
+          echo get_class($e) . ": " . $e->getMessage() . "\n";
+      }
+      """
+    When it is executed
+    Then its output should contain:
+      """
+      Pairs: true
+      Cassandra\Exception\LogicException: Cassandra\Rows cannot be iterated by reference
+      """
+
+  Scenario: Results carry an execution timing breakdown when enabled
+    Given the following ini settings:
+      """ini
+      cassandra.execution_info=1
+      """
+    And the following example:
+      """php
+      <?php
+      $cluster   = Cassandra::cluster()
+                     ->withContactPoints('127.0.0.1')
+                     ->build();
+      $session   = $cluster->connect("simplex");
+      $statement = new Cassandra\SimpleStatement("SELECT * FROM playlists");
+      $result    = $session->execute($statement);
+      $info      = $result->executionInfo();
+
+      echo "Row count: " . $info['row_count'] . "\n";
+      echo "Ordered: " . var_export($info['bind_start'] <= $info['submit'] &&
+                                    $info['submit'] <= $info['response'] &&
+                                    $info['response'] <= $info['decode_end'], true) . "\n";
+      """
+    When it is executed
+    Then its output should contain:
+      """
+      Row count: 0
+      Ordered: true
+      """
+
+  # Requires version 2.5.0 or later of the C/C++ driver
+  Scenario: Requests that exceed their timeout are timed out by the driver
+    Given the following example:
+      """php
+      <?php
+      $cluster   = Cassandra::cluster()
+                     ->withContactPoints('127.0.0.1')
+                     ->build();
+      $session   = $cluster->connect("simplex");
+      $statement = new Cassandra\SimpleStatement("SELECT * FROM system.schema_columns");
+      $options   = new Cassandra\ExecutionOptions(array('timeout' => 0.001));
+      $futures   = array();
+
+      for ($i = 0; $i < 1000; $i++) {
+          $futures[] = $session->executeAsync($statement, $options);
+      }
+
+      $timeouts = 0;
+      foreach ($futures as $future) {
+          try {
+              $future->get();
+          } catch (Cassandra\Exception\TimeoutException $e) {
+              $timeouts++;
+          }
+      }
+
+      echo "Timed out by the driver: " . var_export($timeouts > 0, true) . "\n";
+      """
+    When it is executed
+    Then its output should contain:
+      """
+      Timed out by the driver: true
+      """
+
+  Scenario: Execution info counts the bytes of the decoded values
+    Given the following ini settings:
+      """ini
+      cassandra.execution_info=1
+      """
+    And the following example:
+      """php
+      <?php
+      $cluster   = Cassandra::cluster()
+                     ->withContactPoints('127.0.0.1')
+                     ->build();
+      $session   = $cluster->connect("system");
+      $statement = new Cassandra\SimpleStatement("SELECT key FROM local");
+      $info      = $session->execute($statement)->executionInfo();
+
+      echo "Row count: " . $info['row_count'] . "\n";
+      echo "Result size: " . $info['result_size'] . "\n";
+      """
+    When it is executed
+    Then its output should contain:
+      """
+      Row count: 1
+      Result size: 5
+      """
+
+  Scenario: Statement statistics are aggregated per CQL text
+    Given the following ini settings:
+      """ini
+      cassandra.stats_size=64
+      """
+    And the following example:
+      """php
+      <?php
+      $cluster   = Cassandra::cluster()
+                     ->withContactPoints('127.0.0.1')
+                     ->build();
+      $session   = $cluster->connect("simplex");
+      $statement = new Cassandra\SimpleStatement("SELECT * FROM playlists");
+
+      $session->execute($statement);
+      $session->executeAsync($statement)->get();
+
+      // Statistics are recorded on a driver thread once the response arrives
+      usleep(100000);
+
+      foreach (Cassandra\Stats::statements() as $stats) {
+          echo $stats['cql'] . ": " . $stats['calls'] . " calls, " .
+               $stats['errors'] . " errors\n";
+      }
+      """
+    When it is executed
+    Then its output should contain:
+      """
+      SELECT * FROM playlists: 2 calls, 0 errors
+      """
+
+  Scenario: Results can be recorded and decoded again without a cluster
+    Given the following ini settings:
+      """ini
+      cassandra.record_results=results.rec
+      """
+    And the following example:
+      """php
+      <?php
+      $cluster   = Cassandra::cluster()
+                     ->withContactPoints('127.0.0.1')
+                     ->build();
+      $session   = $cluster->connect("simplex");
+      $statement = new Cassandra\SimpleStatement(
+          "INSERT INTO playlists (id, song_id, artist, title, album)
+           VALUES (62c36092-82a1-3a00-93d1-46196ee77204, ?, ?, ?, ?)"
+      );
+      $session->execute($statement, new Cassandra\ExecutionOptions(array(
+          'arguments' => array(
+              new Cassandra\Uuid('756716f7-2e54-4715-9f00-91dcbea6cf50'),
+              'Joséphine Baker', 'La Petite Tonkinoise', 'Bye Bye Blackbird'
+          )
+      )));
+
+      $live = $session->execute(new Cassandra\SimpleStatement("SELECT * FROM playlists"));
+
+      foreach (Cassandra\Recording::replay("results.rec") as $rows) {
+          echo "Replayed " . count($rows) . " row(s)\n";
+          echo "Equal: " . var_export($rows[0] == $live[0], true) . "\n";
+      }
+      """
+    When it is executed
+    Then its output should contain:
+      """
+      Replayed 1 row(s)
+      Equal: true
+      """
+
+  Scenario: Recorded results keep the element types of collections
+    Given the following ini settings:
+      """ini
+      cassandra.record_results=collections.rec
+      """
+    And the following example:
+      """php
+      <?php
+      $cluster = Cassandra::cluster()
+                   ->withContactPoints('127.0.0.1')
+                   ->build();
+      $session = $cluster->connect("simplex");
+      $session->execute(new Cassandra\SimpleStatement(
+          "INSERT INTO albums (id, tracks, genres, ratings)
+           VALUES (1, ['Bye Bye Blackbird', 'La Petite Tonkinoise'],
+                   {'jazz', 'chanson'}, {'critics': 4, 'listeners': 5})"
+      ));
+
+      $live = $session->execute(new Cassandra\SimpleStatement("SELECT * FROM albums"));
+
+      foreach (Cassandra\Recording::replay("collections.rec") as $rows) {
+          $row = $rows[0];
+          echo "tracks: " . $row['tracks']->type() . "\n";
+          echo "genres: " . $row['genres']->type() . "\n";
+          echo "ratings: " . $row['ratings']->keyType() . " => " .
+               $row['ratings']->valueType() . "\n";
+          echo "Equal: " . var_export($row == $live[0], true) . "\n";
+      }
+      """
+    When it is executed
+    Then its output should contain:
+      """
+      tracks: varchar
+      genres: varchar
+      ratings: varchar => int
+      Equal: true
+      """
@@ -0,0 +1,980 @@
+<?php
+
+/**
+ * A scriptable stand-in for a Cassandra node speaking native protocol v1-v3.
+ *
+ * The server answers STARTUP, OPTIONS, REGISTER, QUERY, PREPARE, EXECUTE and
+ * BATCH requests with canned or generated results. It is meant for load
+ * testing the full PHP -> driver -> socket path without a real cluster, and
+ * knows just enough about the system tables for the driver's control
+ * connection to be happy.
+ *
+ * Usage: php support/native_server.php [--host=127.0.0.1] [--port=9042]
+ *                                      [--rows=10] [--latency-ms=0]
+ *                                      [--error-rate=0] [--config=rules.json]
+ *
+ * The optional configuration file is a JSON document of the form:
+ *
+ *     {
+ *       "latency_ms": 1,
+ *       "rules": [
+ *         {
+ *           "match": "SELECT .* FROM users",
+ *           "columns": {"id": "uuid", "name": "varchar", "tags": "set<varchar>"},
+ *           "rows": 1000,
+ *           "params": ["uuid"],
+ *           "latency_ms": 5,
+ *           "latency_jitter_ms": 2
+ *         },
+ *         {"match": "^INSERT", "error": "write_timeout", "error_rate": 0.01}
+ *       ]
+ *     }
+ *
+ * Rules are matched in order against the CQL text of every request, "rows"
+ * is either a number of rows to generate or a list of literal rows, and
+ * "error" is one of server, overloaded, unavailable, read_timeout,
+ * write_timeout or invalid.
+ */
+class NativeProtocolServer
+{
+    const MAX_VERSION = 3;
+
+    const OPCODE_ERROR     = 0x00;
+    const OPCODE_STARTUP   = 0x01;
+    const OPCODE_READY     = 0x02;
+    const OPCODE_OPTIONS   = 0x05;
+    const OPCODE_SUPPORTED = 0x06;
+    const OPCODE_QUERY     = 0x07;
+    const OPCODE_RESULT    = 0x08;
+    const OPCODE_PREPARE   = 0x09;
+    const OPCODE_EXECUTE   = 0x0A;
+    const OPCODE_REGISTER  = 0x0B;
+    const OPCODE_BATCH     = 0x0D;
+
+    const RESULT_VOID         = 0x0001;
+    const RESULT_ROWS         = 0x0002;
+    const RESULT_SET_KEYSPACE = 0x0003;
+    const RESULT_PREPARED     = 0x0004;
+
+    private static $types = array(
+        'custom'    => 0x0000,
+        'ascii'     => 0x0001,
+        'bigint'    => 0x0002,
+        'blob'      => 0x0003,
+        'boolean'   => 0x0004,
+        'counter'   => 0x0005,
+        'decimal'   => 0x0006,
+        'double'    => 0x0007,
+        'float'     => 0x0008,
+        'int'       => 0x0009,
+        'text'      => 0x000A,
+        'timestamp' => 0x000B,
+        'uuid'      => 0x000C,
+        'varchar'   => 0x000D,
+        'varint'    => 0x000E,
+        'timeuuid'  => 0x000F,
+        'inet'      => 0x0010,
+        'list'      => 0x0020,
+        'map'       => 0x0021,
+        'set'       => 0x0022,
+    );
+
+    private $host;
+    private $port;
+    private $rows;
+    private $latency;
+    private $errorRate;
+    private $rules;
+    private $socket;
+    private $clients;
+    private $pending;
+    private $sequence;
+    private $prepared;
+
+    public function __construct($host, $port, array $config = array())
+    {
+        $this->host      = $host;
+        $this->port      = $port;
+        $this->rows      = isset($config['rows']) ? (int) $config['rows'] : 10;
+        $this->latency   = isset($config['latency_ms']) ? (float) $config['latency_ms'] : 0.0;
+        $this->errorRate = isset($config['error_rate']) ? (float) $config['error_rate'] : 0.0;
+        $this->rules     = isset($config['rules']) ? $config['rules'] : array();
+        $this->clients   = array();
+        $this->pending   = new SplMinHeap();
+        $this->sequence  = 0;
+        $this->prepared  = array();
+    }
+
+    public function listen()
+    {
+        $address      = "tcp://{$this->host}:{$this->port}";
+        $this->socket = @stream_socket_server($address, $errno, $errstr);
+
+        if (!$this->socket) {
+            throw new RuntimeException("Unable to listen on {$address}: {$errstr}");
+        }
+
+        stream_set_blocking($this->socket, false);
+    }
+
+    public function run()
+    {
+        while (true) {
+            $this->flushPending();
+
+            $read   = array($this->socket);
+            $write  = array();
+            $except = null;
+
+            foreach ($this->clients as $client) {
+                $read[] = $client->socket;
+                if ($client->output !== '') {
+                    $write[] = $client->socket;
+                }
+            }
+
+            list($seconds, $microseconds) = $this->selectTimeout();
+
+            if (@stream_select($read, $write, $except, $seconds, $microseconds) === false) {
+                continue;
+            }
+
+            foreach ($read as $socket) {
+                if ($socket === $this->socket) {
+                    $this->accept();
+                } else {
+                    $this->receive($this->clients[(int) $socket]);
+                }
+            }
+
+            foreach ($write as $socket) {
+                if (isset($this->clients[(int) $socket])) {
+                    $this->send($this->clients[(int) $socket]);
+                }
+            }
+        }
+    }
+
+    private function selectTimeout()
+    {
+        if ($this->pending->isEmpty()) {
+            return array(null, 0);
+        }
+
+        $top   = $this->pending->top();
+        $delay = max(0, $top[0] - microtime(true));
+
+        return array((int) $delay, (int) (($delay - (int) $delay) * 1000000));
+    }
+
+    private function flushPending()
+    {
+        $now = microtime(true);
+
+        while (!$this->pending->isEmpty()) {
+            $top = $this->pending->top();
+            if ($top[0] > $now) {
+                break;
+            }
+
+            $this->pending->extract();
+            if (isset($this->clients[$top[2]])) {
+                $this->clients[$top[2]]->output .= $top[3];
+            }
+        }
+    }
+
+    private function accept()
+    {
+        $socket = @stream_socket_accept($this->socket, 0);
+
+        if (!$socket) {
+            return;
+        }
+
+        stream_set_blocking($socket, false);
+
+        $client          = new stdClass();
+        $client->socket  = $socket;
+        $client->input   = '';
+        $client->output  = '';
+
+        $this->clients[(int) $socket] = $client;
+    }
+
+    private function close($client)
+    {
+        unset($this->clients[(int) $client->socket]);
+        fclose($client->socket);
+    }
+
+    private function send($client)
+    {
+        $written = @fwrite($client->socket, $client->output);
+
+        if ($written === false) {
+            $this->close($client);
+            return;
+        }
+
+        $client->output = (string) substr($client->output, $written);
+    }
+
+    private function receive($client)
+    {
+        $data = @fread($client->socket, 65536);
+
+        if ($data === false || ($data === '' && feof($client->socket))) {
+            $this->close($client);
+            return;
+        }
+
+        $client->input .= $data;
+
+        while (($frame = $this->nextFrame($client)) !== null) {
+            $this->dispatch($client, $frame);
+        }
+    }
+
+    private function nextFrame($client)
+    {
+        if (strlen($client->input) < 1) {
+            return null;
+        }
+
+        $version    = ord($client->input[0]) & 0x7F;
+        $headerSize = $version >= 3 ? 9 : 8;
+
+        if (strlen($client->input) < $headerSize) {
+            return null;
+        }
+
+        if ($version >= 3) {
+            $header = unpack('Cversion/Cflags/nstream/Copcode/Nlength', $client->input);
+        } else {
+            $header = unpack('Cversion/Cflags/Cstream/Copcode/Nlength', $client->input);
+        }
+
+        if (strlen($client->input) < $headerSize + $header['length']) {
+            return null;
+        }
+
+        $header['version'] = $version;
+        $header['body']    = substr($client->input, $headerSize, $header['length']);
+        $client->input     = (string) substr($client->input, $headerSize + $header['length']);
+
+        return $header;
+    }
+
+    private function dispatch($client, array $frame)
+    {
+        $version = $frame['version'];
+
+        if ($version < 1 || $version > self::MAX_VERSION) {
+            // Reply using the highest supported version so that the driver
+            // can negotiate down.
+            $version  = min(max($version, 1), self::MAX_VERSION);
+            $response = $this->error(0x000A, "Invalid or unsupported protocol version ({$frame['version']}); supported versions are (1/v1, 2/v2, 3/v3)");
+        } else {
+            try {
+                $response = $this->handle($frame['opcode'], new NativeProtocolReader($frame['body'], $version), $version);
+            } catch (Exception $e) {
+                $response = $this->error(0x000A, $e->getMessage());
+            }
+        }
+
+        list($opcode, $body, $delay) = $response;
+
+        $data = NativeProtocolWriter::frame($version, $frame['stream'], $opcode, $body);
+
+        if ($delay > 0) {
+            $this->pending->insert(array(microtime(true) + $delay, $this->sequence++, (int) $client->socket, $data));
+        } else {
+            $client->output .= $data;
+        }
+    }
+
+    private function handle($opcode, NativeProtocolReader $reader, $version)
+    {
+        switch ($opcode) {
+        case self::OPCODE_STARTUP:
+        case self::OPCODE_REGISTER:
+            return array(self::OPCODE_READY, '', 0);
+        case self::OPCODE_OPTIONS:
+            return array(self::OPCODE_SUPPORTED, NativeProtocolWriter::stringMultimap(array(
+                'CQL_VERSION' => array('3.2.0'),
+                'COMPRESSION' => array(),
+            )), 0);
+        case self::OPCODE_QUERY:
+            $cql = $reader->longString();
+            return $this->query($cql, $reader->queryParameters(), $version);
+        case self::OPCODE_PREPARE:
+            return $this->prepare($reader->longString(), $version);
+        case self::OPCODE_EXECUTE:
+            $id = $reader->shortBytes();
+            if (!isset($this->prepared[$id])) {
+                return $this->unprepared($id);
+            }
+            $options = $version == 1 ? $reader->executeParametersV1() : $reader->queryParameters();
+            return $this->query($this->prepared[$id], $options, $version);
+        case self::OPCODE_BATCH:
+            return $this->batch($reader, $version);
+        default:
+            return $this->error(0x000A, "Unsupported opcode {$opcode}");
+        }
+    }
+
+    private function query($cql, array $options, $version)
+    {
+        if (preg_match('/^\s*USE\s+"?(\w+)"?/i', $cql, $matches)) {
+            return $this->result(NativeProtocolWriter::int(self::RESULT_SET_KEYSPACE) .
+                                 NativeProtocolWriter::string($matches[1]));
+        }
+
+        $system = $this->systemQuery($cql, $version);
+        if ($system !== null) {
+            return $this->result($system);
+        }
+
+        $rule  = $this->rule($cql);
+        $delay = $this->delay($rule);
+        $rate  = isset($rule['error_rate']) ? (float) $rule['error_rate'] : $this->errorRate;
+
+        if (isset($rule['error']) && ($rate <= 0 || $this->chance($rate))) {
+            return $this->configuredError($rule['error'], $options, $delay);
+        }
+
+        if (!isset($rule['error']) && $rate > 0 && $this->chance($rate)) {
+            return $this->configuredError('server', $options, $delay);
+        }
+
+        if (!isset($rule['columns'])) {
+            return $this->result(NativeProtocolWriter::int(self::RESULT_VOID), $delay);
+        }
+
+        $rows   = isset($rule['rows']) ? $rule['rows'] : $this->rows;
+        $offset = 0;
+        $total  = is_array($rows) ? count($rows) : (int) $rows;
+        $count  = $total;
+
+        if (isset($options['paging_state'])) {
+            $state  = unpack('Noffset', $options['paging_state']);
+            $offset = $state['offset'];
+        }
+
+        if (isset($options['page_size']) && $options['page_size'] > 0) {
+            $count = min($options['page_size'], $total - $offset);
+        } else {
+            $count = $total - $offset;
+        }
+
+        $next = $offset + $count < $total ? pack('N', $offset + $count) : null;
+        $data = array();
+
+        for ($i = $offset; $i < $offset + $count; $i++) {
+            $data[] = is_array($rows) ? array_values($rows[$i]) : null;
+        }
+
+        return $this->result($this->rowsResult($rule['columns'], $data, $offset, $next, $version), $delay);
+    }
+
+    private function prepare($cql, $version)
+    {
+        $id   = md5($cql, true);
+        $rule = $this->rule($cql);
+
+        $this->prepared[$id] = $cql;
+
+        $params = isset($rule['params']) ? $rule['params'] : array();
+        $count  = substr_count($cql, '?');
+        $bind   = array();
+
+        for ($i = 0; $i < $count; $i++) {
+            $bind["p{$i}"] = isset($params[$i]) ? $params[$i] : 'varchar';
+        }
+
+        $body = NativeProtocolWriter::int(self::RESULT_PREPARED) .
+                NativeProtocolWriter::shortBytes($id) .
+                $this->metadata($bind, null);
+
+        if ($version >= 2) {
+            $body .= isset($rule['columns']) ?
+                     $this->metadata($rule['columns'], null) :
+                     NativeProtocolWriter::int(0x0004) . NativeProtocolWriter::int(0);
+        }
+
+        return $this->result($body, $this->delay($rule));
+    }
+
+    private function batch(NativeProtocolReader $reader, $version)
+    {
+        $reader->byte();
+        $count    = $reader->short();
+        $response = $this->result(NativeProtocolWriter::int(self::RESULT_VOID));
+
+        for ($i = 0; $i < $count; $i++) {
+            if ($reader->byte() == 0) {
+                $cql = $reader->longString();
+            } else {
+                $id = $reader->shortBytes();
+                if (!isset($this->prepared[$id])) {
+                    return $this->unprepared($id);
+                }
+                $cql = $this->prepared[$id];
+            }
+
+            $values = $reader->short();
+            for ($j = 0; $j < $values; $j++) {
+                $reader->bytes();
+            }
+
+            $statement = $this->query($cql, array(), $version);
+
+            // the batch takes as long as its slowest statement and fails
+            // if any of them does
+            if ($statement[0] == self::OPCODE_ERROR) {
+                $response = $statement;
+            }
+            $response[2] = max($response[2], $statement[2]);
+        }
+
+        return $response;
+    }
+
+    private function systemQuery($cql, $version)
+    {
+        if (preg_match('/FROM\s+system\.local/i', $cql)) {
+            return $this->rowsResult(array(
+                'key'                     => 'varchar',
+                'bootstrapped'            => 'varchar',
+                'cluster_name'            => 'varchar',
+                'cql_version'             => 'varchar',
+                'data_center'             => 'varchar',
+                'host_id'                 => 'uuid',
+                'native_protocol_version' => 'varchar',
+                'partitioner'             => 'varchar',
+                'rack'                    => 'varchar',
+                'release_version'         => 'varchar',
+                'rpc_address'             => 'inet',
+                'schema_version'          => 'uuid',
+                'tokens'                  => 'set<varchar>',
+            ), array(array(
+                'local',
+                'COMPLETED',
+                'stub',
+                '3.2.0',
+                'dc1',
+                '2f1a5a9c-0000-4000-8000-000000000001',
+                (string) self::MAX_VERSION,
+                'org.apache.cassandra.dht.Murmur3Partitioner',
+                'rack1',
+                '2.1.9',
+                $this->host == '0.0.0.0' ? '127.0.0.1' : $this->host,
+                '2f1a5a9c-0000-4000-8000-000000000002',
+                array('0'),
+            )), 0, null, $version);
+        }
+
+        if (preg_match('/FROM\s+system\.peers/i', $cql)) {
+            return $this->rowsResult(array(
+                'peer'            => 'inet',
+                'data_center'     => 'varchar',
+                'host_id'         => 'uuid',
+                'rack'            => 'varchar',
+                'release_version' => 'varchar',
+                'rpc_address'     => 'inet',
+                'schema_version'  => 'uuid',
+                'tokens'          => 'set<varchar>',
+            ), array(), 0, null, $version);
+        }
+
+        if (preg_match('/FROM\s+(system\.schema_|system_schema\.)\w+/i', $cql)) {
+            return $this->rowsResult(array(
+                'keyspace_name' => 'varchar',
+            ), array(), 0, null, $version);
+        }
+
+        return null;
+    }
+
+    private function rule($cql)
+    {
+        foreach ($this->rules as $rule) {
+            if (preg_match('/' . str_replace('/', '\/', $rule['match']) . '/i', $cql)) {
+                return $rule;
+            }
+        }
+
+        if (preg_match('/^\s*SELECT/i', $cql)) {
+            return array('columns' => array('key' => 'varchar', 'value' => 'bigint'));
+        }
+
+        return array();
+    }
+
+    private function delay(array $rule)
+    {
+        $latency = isset($rule['latency_ms']) ? (float) $rule['latency_ms'] : $this->latency;
+
+        if (isset($rule['latency_jitter_ms'])) {
+            $latency += mt_rand(0, (int) ($rule['latency_jitter_ms'] * 1000)) / 1000;
+        }
+
+        return $latency / 1000;
+    }
+
+    private function chance($rate)
+    {
+        return mt_rand() / mt_getrandmax() < $rate;
+    }
+
+    private function result($body, $delay = 0)
+    {
+        return array(self::OPCODE_RESULT, $body, $delay);
+    }
+
+    private function error($code, $message, $extra = '', $delay = 0)
+    {
+        return array(self::OPCODE_ERROR,
+                     NativeProtocolWriter::int($code) . NativeProtocolWriter::string($message) . $extra,
+                     $delay);
+    }
+
+    private function unprepared($id)
+    {
+        return $this->error(0x2500, 'Prepared query with ID ' . bin2hex($id) . ' not found',
+                            NativeProtocolWriter::shortBytes($id));
+    }
+
+    private function configuredError($name, array $options, $delay)
+    {
+        $consistency = isset($options['consistency']) ? $options['consistency'] : 0x0001;
+
+        switch ($name) {
+        case 'overloaded':
+            return $this->error(0x1001, 'Server is overloaded', '', $delay);
+        case 'unavailable':
+            return $this->error(0x1000, 'Cannot achieve consistency level',
+                                NativeProtocolWriter::short($consistency) .
+                                NativeProtocolWriter::int(1) .
+                                NativeProtocolWriter::int(0), $delay);
+        case 'write_timeout':
+            return $this->error(0x1100, 'Operation timed out - received only 0 responses.',
+                                NativeProtocolWriter::short($consistency) .
+                                NativeProtocolWriter::int(0) .
+                                NativeProtocolWriter::int(1) .
+                                NativeProtocolWriter::string('SIMPLE'), $delay);
+        case 'read_timeout':
+            return $this->error(0x1200, 'Operation timed out - received only 0 responses.',
+                                NativeProtocolWriter::short($consistency) .
+                                NativeProtocolWriter::int(0) .
+                                NativeProtocolWriter::int(1) .
+                                "\x00", $delay);
+        case 'invalid':
+            return $this->error(0x2200, 'Invalid query', '', $delay);
+        default:
+            return $this->error(0x0000, 'Server error', '', $delay);
+        }
+    }
+
+    private function metadata(array $columns, $pagingState)
+    {
+        $flags = 0x0001 | ($pagingState !== null ? 0x0002 : 0);
+        $body  = NativeProtocolWriter::int($flags) .
+                 NativeProtocolWriter::int(count($columns));
+
+        if ($pagingState !== null) {
+            $body .= NativeProtocolWriter::bytes($pagingState);
+        }
+
+        $body .= NativeProtocolWriter::string('stub') .
+                 NativeProtocolWriter::string('stub');
+
+        foreach ($columns as $name => $type) {
+            $body .= NativeProtocolWriter::string($name) . $this->typeOption($type);
+        }
+
+        return $body;
+    }
+
+    private function rowsResult(array $columns, array $rows, $offset, $pagingState, $version)
+    {
+        $types = array_values($columns);
+        $body  = NativeProtocolWriter::int(self::RESULT_ROWS) .
+                 $this->metadata($columns, $pagingState) .
+                 NativeProtocolWriter::int(count($rows));
+
+        foreach ($rows as $index => $row) {
+            foreach ($types as $column => $type) {
+                $value = $row === null ?
+                         NativeProtocolValues::generate($type, $offset + $index, $column) :
+                         $row[$column];
+                $body .= NativeProtocolWriter::bytes(NativeProtocolValues::encode($type, $value, $version));
+            }
+        }
+
+        return $body;
+    }
+
+    private function typeOption($type)
+    {
+        $type = strtolower(trim($type));
+
+        if (preg_match('/^(list|set)<(.+)>$/', $type, $matches)) {
+            return NativeProtocolWriter::short(self::$types[$matches[1]]) .
+                   $this->typeOption($matches[2]);
+        }
+
+        if (preg_match('/^map<([^,]+),(.+)>$/', $type, $matches)) {
+            return NativeProtocolWriter::short(self::$types['map']) .
+                   $this->typeOption($matches[1]) .
+                   $this->typeOption($matches[2]);
+        }
+
+        if (!isset(self::$types[$type])) {
+            throw new InvalidArgumentException("Unsupported type {$type}");
+        }
+
+        return NativeProtocolWriter::short(self::$types[$type]);
+    }
+}
+
+class NativeProtocolReader
+{
+    private $data;
+    private $position;
+    private $version;
+
+    public function __construct($data, $version)
+    {
+        $this->data     = $data;
+        $this->position = 0;
+        $this->version  = $version;
+    }
+
+    public function byte()
+    {
+        return ord($this->read(1));
+    }
+
+    public function short()
+    {
+        $value = unpack('n', $this->read(2));
+        return $value[1];
+    }
+
+    public function int()
+    {
+        $value = unpack('N', $this->read(4));
+        $value = $value[1];
+        return $value > 0x7FFFFFFF ? $value - 0x100000000 : $value;
+    }
+
+    public function string()
+    {
+        return $this->read($this->short());
+    }
+
+    public function longString()
+    {
+        return $this->read($this->int());
+    }
+
+    public function bytes()
+    {
+        $length = $this->int();
+        return $length < 0 ? null : $this->read($length);
+    }
+
+    public function shortBytes()
+    {
+        return $this->read($this->short());
+    }
+
+    public function queryParameters()
+    {
+        $options = array('consistency' => $this->short());
+
+        if ($this->version == 1) {
+            return $options;
+        }
+
+        $flags = $this->byte();
+
+        if ($flags & 0x01) {
+            $count = $this->short();
+            for ($i = 0; $i < $count; $i++) {
+                if ($flags & 0x40) {
+                    $this->string();
+                }
+                $this->bytes();
+            }
+        }
+
+        if ($flags & 0x04) {
+            $options['page_size'] = $this->int();
+        }
+
+        if ($flags & 0x08) {
+            $options['paging_state'] = $this->bytes();
+        }
+
+        return $options;
+    }
+
+    public function executeParametersV1()
+    {
+        $count = $this->short();
+
+        for ($i = 0; $i < $count; $i++) {
+            $this->bytes();
+        }
+
+        return array('consistency' => $this->short());
+    }
+
+    private function read($length)
+    {
+        if ($length < 0 || $this->position + $length > strlen($this->data)) {
+            throw new UnexpectedValueException('Truncated frame');
+        }
+
+        $value = (string) substr($this->data, $this->position, $length);
+        $this->position += $length;
+
+        return $value;
+    }
+}
+
+class NativeProtocolWriter
+{
+    public static function frame($version, $stream, $opcode, $body)
+    {
+        if ($version >= 3) {
+            $header = pack('CCnCN', 0x80 | $version, 0, $stream, $opcode, strlen($body));
+        } else {
+            $header = pack('CCCCN', 0x80 | $version, 0, $stream, $opcode, strlen($body));
+        }
+
+        return $header . $body;
+    }
+
+    public static function short($value)
+    {
+        return pack('n', $value);
+    }
+
+    public static function int($value)
+    {
+        return pack('N', $value);
+    }
+
+    public static function string($value)
+    {
+        return pack('n', strlen($value)) . $value;
+    }
+
+    public static function longString($value)
+    {
+        return pack('N', strlen($value)) . $value;
+    }
+
+    public static function bytes($value)
+    {
+        return $value === null ? pack('N', -1) : pack('N', strlen($value)) . $value;
+    }
+
+    public static function shortBytes($value)
+    {
+        return pack('n', strlen($value)) . $value;
+    }
+
+    public static function stringMultimap(array $map)
+    {
+        $body = pack('n', count($map));
+
+        foreach ($map as $key => $values) {
+            $body .= self::string($key) . pack('n', count($values));
+            foreach ($values as $value) {
+                $body .= self::string($value);
+            }
+        }
+
+        return $body;
+    }
+}
+
+class NativeProtocolValues
+{
+    /**
+     * Generates a deterministic value of the given type for a row.
+     */
+    public static function generate($type, $row, $column)
+    {
+        $type = strtolower(trim($type));
+
+        if (preg_match('/^(list|set)<(.+)>$/', $type, $matches)) {
+            return array(
+                self::generate($matches[2], $row, $column),
+                self::generate($matches[2], $row + 1, $column),
+                self::generate($matches[2], $row + 2, $column),
+            );
+        }
+
+        if (preg_match('/^map<([^,]+),(.+)>$/', $type, $matches)) {
+            return array(
+                array(self::generate($matches[1], $row, $column), self::generate($matches[2], $row, $column)),
+                array(self::generate($matches[1], $row + 1, $column), self::generate($matches[2], $row + 1, $column)),
+            );
+        }
+
+        switch ($type) {
+        case 'ascii':
+        case 'text':
+        case 'varchar':
+            return "value-{$column}-{$row}";
+        case 'blob':
+            return str_repeat(chr($row & 0xFF), 16);
+        case 'boolean':
+            return $row % 2 == 0;
+        case 'double':
+        case 'float':
+            return $row + 0.5;
+        case 'decimal':
+            return "{$row}.25";
+        case 'inet':
+            return long2ip(0x0A000000 + ($row & 0xFFFFFF));
+        case 'timestamp':
+            return 1420070400000 + $row;
+        case 'timeuuid':
+            return sprintf('%08x-0000-1000-8000-%012x', $row, $column);
+        case 'uuid':
+            return sprintf('%08x-0000-4000-8000-%012x', $row, $column);
+        default:
+            return $row;
+        }
+    }
+
+    /**
+     * Serializes a PHP literal as a value of the given type.
+     */
+    public static function encode($type, $value, $version)
+    {
+        if ($value === null) {
+            return null;
+        }
+
+        $type = strtolower(trim($type));
+
+        if (preg_match('/^(list|set)<(.+)>$/', $type, $matches)) {
+            $body = self::count(count($value), $version);
+            foreach ($value as $element) {
+                $body .= self::element(self::encode($matches[2], $element, $version), $version);
+            }
+            return $body;
+        }
+
+        if (preg_match('/^map<([^,]+),(.+)>$/', $type, $matches)) {
+            $body = self::count(count($value), $version);
+            foreach ($value as $entry) {
+                $body .= self::element(self::encode($matches[1], $entry[0], $version), $version) .
+                         self::element(self::encode($matches[2], $entry[1], $version), $version);
+            }
+            return $body;
+        }
+
+        switch ($type) {
+        case 'ascii':
+        case 'blob':
+        case 'text':
+        case 'varchar':
+            return (string) $value;
+        case 'boolean':
+            return $value ? "\x01" : "\x00";
+        case 'int':
+            return pack('N', $value);
+        case 'bigint':
+        case 'counter':
+        case 'timestamp':
+            return self::long($value);
+        case 'double':
+            return self::bigEndian(pack('d', $value));
+        case 'float':
+            return self::bigEndian(pack('f', $value));
+        case 'varint':
+            return self::varint((int) $value);
+        case 'decimal':
+            $parts = explode('.', (string) $value, 2);
+            $scale = isset($parts[1]) ? strlen($parts[1]) : 0;
+            return pack('N', $scale) . self::varint((int) ($parts[0] . (isset($parts[1]) ? $parts[1] : '')));
+        case 'inet':
+            return inet_pton($value);
+        case 'timeuuid':
+        case 'uuid':
+            return pack('H*', str_replace('-', '', $value));
+        default:
+            throw new InvalidArgumentException("Unsupported type {$type}");
+        }
+    }
+
+    private static function count($count, $version)
+    {
+        return $version >= 3 ? pack('N', $count) : pack('n', $count);
+    }
+
+    private static function element($bytes, $version)
+    {
+        return $version >= 3 ? pack('N', strlen($bytes)) . $bytes : pack('n', strlen($bytes)) . $bytes;
+    }
+
+    private static function long($value)
+    {
+        return pack('NN', ($value >> 32) & 0xFFFFFFFF, $value & 0xFFFFFFFF);
+    }
+
+    private static function varint($value)
+    {
+        $bytes = self::long($value);
+
+        // strip redundant sign extension bytes
+        while (strlen($bytes) > 1 &&
+               (($bytes[0] === "\x00" && (ord($bytes[1]) & 0x80) == 0) ||
+                ($bytes[0] === "\xFF" && (ord($bytes[1]) & 0x80) != 0))) {
+            $bytes = substr($bytes, 1);
+        }
+
+        return $bytes;
+    }
+
+    private static function bigEndian($bytes)
+    {
+        return pack('S', 1) === "\x01\x00" ? strrev($bytes) : $bytes;
+    }
+}
+
+if (realpath($_SERVER['SCRIPT_FILENAME']) === __FILE__) {
+    $options = getopt('', array('host:', 'port:', 'rows:', 'latency-ms:', 'error-rate:', 'config:'));
+    $config  = array();
+
+    if (isset($options['config'])) {
+        $config = json_decode(file_get_contents($options['config']), true);
+        if (!is_array($config)) {
+            fwrite(STDERR, "Unable to parse {$options['config']}" . PHP_EOL);
+            exit(1);
+        }
+    }
+
+    foreach (array('rows' => 'rows', 'latency-ms' => 'latency_ms', 'error-rate' => 'error_rate') as $option => $key) {
+        if (isset($options[$option])) {
+            $config[$key] = $options[$option];
+        }
+    }
+
+    $host   = isset($options['host']) ? $options['host'] : '127.0.0.1';
+    $port   = isset($options['port']) ? (int) $options['port'] : 9042;
+    $server = new NativeProtocolServer($host, $port, $config);
+
+    $server->listen();
+    fwrite(STDERR, "Listening on {$host}:{$port}" . PHP_EOL);
+    $server->run();
+}
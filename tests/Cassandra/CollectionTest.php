@@ -122,4 +122,61 @@ class CollectionTest extends \PHPUnit_Framework_TestCase
         $this->assertEquals(new Varint('7'), $list->get(6));
         $this->assertEquals(new Varint('8'), $list->get(7));
     }
+
+    public function testSupportsIteration()
+    {
+        $list = new Collection(\Cassandra::TYPE_VARINT);
+        $list->add(new Varint('1'), new Varint('2'), new Varint('3'));
+
+        $elements = array();
+        foreach ($list as $index => $element) {
+            $elements[$index] = $element;
+        }
+
+        $this->assertEquals(array(new Varint('1'), new Varint('2'), new Varint('3')), $elements);
+    }
+
+    public function testSupportsNestedIteration()
+    {
+        $list = new Collection(\Cassandra::TYPE_INT);
+        $list->add(1, 2, 3);
+
+        $pairs = 0;
+        foreach ($list as $i => $outer) {
+            foreach ($list as $j => $inner) {
+                $this->assertEquals($i + 1, $outer);
+                $this->assertEquals($j + 1, $inner);
+                $pairs++;
+            }
+        }
+
+        $this->assertEquals(9, $pairs);
+    }
+
+    /**
+     * @expectedException         Cassandra\Exception\LogicException
+     * @expectedExceptionMessage  Cassandra\Collection cannot be iterated by reference
+     */
+    public function testCannotBeIteratedByReference()
+    {
+        $list = new Collection(\Cassandra::TYPE_INT);
+        $list->add(1);
+
+        foreach ($list as &$element) {
+        }
+    }
+
+    /**
+     * @expectedException         PHPUnit_Framework_Error_Notice
+     * @expectedExceptionMessage  Cassandra\Collection was modified during iteration, the iteration stops
+     */
+    public function testStopsIterationWhenTheCurrentElementIsRemoved()
+    {
+        $list = new Collection(\Cassandra::TYPE_INT);
+        $list->add(1, 2, 3);
+
+        foreach ($list as $index => $element) {
+            $list->remove($index);
+        }
+    }
 }
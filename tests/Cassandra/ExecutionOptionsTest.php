@@ -14,7 +14,10 @@ class ExecutionOptionsTest extends \PHPUnit_Framework_TestCase
             'serial_consistency' => \Cassandra::CONSISTENCY_LOCAL_SERIAL,
             'page_size'          => 15000,
             'timeout'            => 15,
-            'arguments'          => array('a', 1, 'b', 2, 'c', 3)
+            'arguments'          => array('a', 1, 'b', 2, 'c', 3),
+            'idempotent'         => true,
+            'retry_policy'       => new RetryPolicy\Fallthrough(),
+            'profile'            => 'oltp_read'
         ));
 
         $this->assertEquals(\Cassandra::CONSISTENCY_ANY, $options->consistency);
@@ -22,6 +25,9 @@ class ExecutionOptionsTest extends \PHPUnit_Framework_TestCase
         $this->assertEquals(15000, $options->pageSize);
         $this->assertEquals(15, $options->timeout);
         $this->assertEquals(array('a', 1, 'b', 2, 'c', 3), $options->arguments);
+        $this->assertTrue($options->idempotent);
+        $this->assertInstanceOf('Cassandra\RetryPolicy\Fallthrough', $options->retryPolicy);
+        $this->assertEquals('oltp_read', $options->profile);
     }
 
     public function testReturnsNullValuesWhenRetrievingUndefinedSettingsByName()
@@ -33,5 +39,17 @@ class ExecutionOptionsTest extends \PHPUnit_Framework_TestCase
         $this->assertNull($options->pageSize);
         $this->assertNull($options->timeout);
         $this->assertNull($options->arguments);
+        $this->assertNull($options->idempotent);
+        $this->assertNull($options->retryPolicy);
+        $this->assertNull($options->profile);
+    }
+
+    /**
+     * @expectedException        Cassandra\Exception\InvalidArgumentException
+     * @expectedExceptionMessage idempotent must be a boolean
+     */
+    public function testThrowsWhenIdempotentIsNotABoolean()
+    {
+        new ExecutionOptions(array('idempotent' => 1));
     }
 }
@@ -49,4 +49,80 @@ class MapTest extends \PHPUnit_Framework_TestCase
         $map = new Map(\Cassandra::TYPE_VARCHAR, \Cassandra::TYPE_VARCHAR);
         $map->set("test", null);
     }
+
+    public function testSupportsIterationWithKeys()
+    {
+        $map = new Map(\Cassandra::TYPE_VARCHAR, \Cassandra::TYPE_INT);
+        $map->set('one', 1);
+        $map->set('two', 2);
+        $map->set('three', 3);
+
+        $entries = array();
+        foreach ($map as $key => $value) {
+            $entries[$key] = $value;
+        }
+
+        $this->assertEquals(array('one' => 1, 'two' => 2, 'three' => 3), $entries);
+    }
+
+    /**
+     * @requires PHP 5.5
+     */
+    public function testIteratesOverKeysOfAnyType()
+    {
+        $map = new Map(\Cassandra::TYPE_VARINT, \Cassandra::TYPE_VARCHAR);
+        $map->set(new Varint('1'), 'one');
+        $map->set(new Varint('2'), 'two');
+
+        $keys = array();
+        foreach ($map as $key => $value) {
+            $keys[] = $key;
+        }
+
+        $this->assertEquals(array(new Varint('1'), new Varint('2')), $keys);
+    }
+
+    public function testSupportsNestedIteration()
+    {
+        $map = new Map(\Cassandra::TYPE_VARCHAR, \Cassandra::TYPE_INT);
+        $map->set('one', 1);
+        $map->set('two', 2);
+
+        $pairs = array();
+        foreach ($map as $outer => $i) {
+            foreach ($map as $inner => $j) {
+                $pairs[] = "$outer:$inner";
+            }
+        }
+
+        $this->assertEquals(array('one:one', 'one:two', 'two:one', 'two:two'), $pairs);
+    }
+
+    /**
+     * @expectedException         Cassandra\Exception\LogicException
+     * @expectedExceptionMessage  Cassandra\Map cannot be iterated by reference
+     */
+    public function testCannotBeIteratedByReference()
+    {
+        $map = new Map(\Cassandra::TYPE_VARCHAR, \Cassandra::TYPE_INT);
+        $map->set('one', 1);
+
+        foreach ($map as &$value) {
+        }
+    }
+
+    /**
+     * @expectedException         PHPUnit_Framework_Error_Notice
+     * @expectedExceptionMessage  Cassandra\Map was modified during iteration, the iteration stops
+     */
+    public function testStopsIterationWhenTheCurrentEntryIsRemoved()
+    {
+        $map = new Map(\Cassandra::TYPE_VARCHAR, \Cassandra::TYPE_INT);
+        $map->set('one', 1);
+        $map->set('two', 2);
+
+        foreach ($map as $key => $value) {
+            $map->remove($key);
+        }
+    }
 }
@@ -93,6 +93,29 @@ class SetTest extends \PHPUnit_Framework_TestCase
         }
     }
 
+    /**
+     * @dataProvider sampleNumbers
+     */
+    public function testSupportsNestedIteration($numbers)
+    {
+        $set = new Set(\Cassandra::TYPE_INT);
+
+        foreach ($numbers as $number) {
+            $set->add($number);
+        }
+
+        $pairs = 0;
+        foreach ($set as $i => $outer) {
+            foreach ($set as $j => $inner) {
+                $this->assertEquals($numbers[$i], $outer);
+                $this->assertEquals($numbers[$j], $inner);
+                $pairs++;
+            }
+        }
+
+        $this->assertEquals(count($numbers) * count($numbers), $pairs);
+    }
+
     /**
      * @dataProvider sampleNumbers
      */
@@ -17,6 +17,12 @@ class CollectionTest extends \PHPUnit_Framework_TestCase
         $this->assertEquals(Type::varchar(), $type->type());
     }
 
+    public function testEqualCollectionTypesAreTheSameInstance()
+    {
+        $this->assertSame(Type::collection(Type::varchar()), Type::collection(Type::varchar()));
+        $this->assertNotSame(Type::collection(Type::varchar()), Type::set(Type::varchar()));
+    }
+
     public function testCreatesCollectionFromValues()
     {
         $list = Type::collection(Type::varchar())
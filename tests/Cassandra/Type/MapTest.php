@@ -36,6 +36,14 @@ class MapTest extends \PHPUnit_Framework_TestCase
         $this->assertEquals(Type::int(), $type->valueType());
     }
 
+    public function testEqualMapTypesAreTheSameInstance()
+    {
+        $this->assertSame(Type::map(Type::varchar(), Type::int()),
+                          Type::map(Type::varchar(), Type::int()));
+        $this->assertNotSame(Type::map(Type::varchar(), Type::int()),
+                             Type::map(Type::int(), Type::varchar()));
+    }
+
     public function testCreatesMapFromValues()
     {
         $map = Type::map(Type::varchar(), Type::int())
@@ -17,6 +17,12 @@ class SetTest extends \PHPUnit_Framework_TestCase
         $this->assertEquals(Type::varchar(), $type->type());
     }
 
+    public function testEqualSetTypesAreTheSameInstance()
+    {
+        $this->assertSame(Type::set(Type::varchar()), Type::set(Type::varchar()));
+        $this->assertNotSame(Type::set(Type::varchar()), Type::set(Type::int()));
+    }
+
     public function testCreatesSetFromValues()
     {
         $set = Type::set(Type::varchar())